@@ -3,26 +3,151 @@
 #include <queue>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+// Lock-free bounded multi-producer/multi-consumer ring (Vyukov). Each slot's
+// sequence number says whose turn it is: free for the producer holding ticket i
+// when seq == i, full for the consumer holding ticket i when seq == i + 1.
+// lab5/Process-Synchronization.cpp keeps a copy of this queue; fix both together.
+template <typename T>
+class MPMCQueue {
+public:
+explicit MPMCQueue(size_t capacity) : limit(std::max<size_t>(capacity, 1)) {
+size_t size = 2;
+while (size < capacity) size <<= 1; // power of two so a mask replaces modulo
+cells.reset(new Cell[size]);
+mask = size - 1;
+for (size_t i = 0; i < size; i++) cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+MPMCQueue(const MPMCQueue&) = delete;
+MPMCQueue& operator=(const MPMCQueue&) = delete;
+bool try_push(const T& value) { // false if full
+size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+for (;;) {
+Cell& cell = cells[pos & mask];
+intptr_t diff = (intptr_t)cell.sequence.load(std::memory_order_acquire) - (intptr_t)pos;
+if (diff == 0) {
+if ((intptr_t)(pos - dequeue_pos.load(std::memory_order_relaxed)) >= (intptr_t)limit) return false; // full at the logical capacity
+if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+cell.data = value;
+cell.sequence.store(pos + 1, std::memory_order_release); // hand the slot to consumers
+return true;
+}
+} else if (diff < 0) {
+return false; // slot still full from the previous lap
+} else {
+pos = enqueue_pos.load(std::memory_order_relaxed); // another producer took this ticket
+}
+}
+}
+bool try_pop(T& value) { // false if empty
+size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+for (;;) {
+Cell& cell = cells[pos & mask];
+intptr_t diff = (intptr_t)cell.sequence.load(std::memory_order_acquire) - (intptr_t)(pos + 1);
+if (diff == 0) {
+if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+value = std::move(cell.data);
+cell.sequence.store(pos + mask + 1, std::memory_order_release); // free for the next lap
+return true;
+}
+} else if (diff < 0) {
+return false; // nothing published here yet
+} else {
+pos = dequeue_pos.load(std::memory_order_relaxed);
+}
+}
+}
+// Blocking wrappers: only park (futex) while full / empty
+void push(const T& value) {
+park_until([&] { return try_push(value); }, space_epoch, producers_parked);
+wake_one(items_epoch, consumers_parked);
+}
+T pop() {
+T value;
+park_until([&] { return try_pop(value); }, items_epoch, consumers_parked);
+wake_one(space_epoch, producers_parked);
+return value;
+}
+size_t capacity() const { return limit; }
+private:
+struct Cell {
+std::atomic<size_t> sequence;
+T data;
+};
+static constexpr int SPIN_LIMIT = 128; // retries before yielding
+static constexpr int YIELD_LIMIT = 16; // yields before sleeping
+template <typename Attempt>
+void park_until(Attempt attempt, std::atomic<int>& epoch, std::atomic<int>& parked) {
+for (int i = 0; i < SPIN_LIMIT + YIELD_LIMIT; i++) {
+if (attempt()) return;
+if (i >= SPIN_LIMIT) std::this_thread::yield();
+}
+for (;;) {
+int seen = epoch.load(std::memory_order_relaxed);
+parked.fetch_add(1, std::memory_order_relaxed);
+std::atomic_thread_fence(std::memory_order_seq_cst); // pairs with wake_one: we see the item or it sees us
+bool done = attempt();
+if (!done) syscall(SYS_futex, reinterpret_cast<int*>(&epoch), FUTEX_WAIT_PRIVATE, seen, nullptr, nullptr, 0);
+parked.fetch_sub(1, std::memory_order_relaxed);
+if (done || attempt()) return;
+}
+}
+static void wake_one(std::atomic<int>& epoch, std::atomic<int>& parked) {
+std::atomic_thread_fence(std::memory_order_seq_cst);
+if (parked.load(std::memory_order_relaxed) == 0) return; // nobody asleep: no syscall
+epoch.fetch_add(1, std::memory_order_relaxed);
+syscall(SYS_futex, reinterpret_cast<int*>(&epoch), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+std::unique_ptr<Cell[]> cells;
+size_t mask;
+size_t limit; // logical capacity, enforced by try_push; the ring is rounded up to a power of two
+alignas(64) std::atomic<size_t> enqueue_pos{0}; // producers' counter, own cache line
+alignas(64) std::atomic<size_t> dequeue_pos{0}; // consumers' counter, own cache line
+alignas(64) std::atomic<int> items_epoch{0}; // futex word for parked consumers
+std::atomic<int> consumers_parked{0};
+alignas(64) std::atomic<int> space_epoch{0}; // futex word for parked producers
+std::atomic<int> producers_parked{0};
+};
 std::queue<int> buffer; // shared buffer
 
 const unsigned int MAX = 5; // max buffer size
 std::mutex mtx; // mutex to protect buffer
 std::condition_variable cv; // condition variable for sync
+MPMCQueue<int> ring(MAX); // lock-free alternative, same MAX items
+bool use_ring = false; // set by --mpmc
 // Producer function
 void producer() {
 for (int i = 1; i <= 10; i++) {
+if (use_ring) {
+ring.push(i); // blocks only while the ring is full
+std::cout << "Produced: " << i << "\n";
+} else {
 std::unique_lock<std::mutex> lock(mtx); // lock buffer
 cv.wait(lock, [] { return buffer.size() < MAX; }); // wait if buffer full
 buffer.push(i); // produce item
 std::cout << "Produced: " << i << "\n";
 cv.notify_all(); // notify consumers
 lock.unlock();
+}
 std::this_thread::sleep_for(std::chrono::milliseconds(100)); // simulate production time
 }
 }
 // Consumer function
 void consumer() {
 for (int i = 1; i <= 10; i++) {
+if (use_ring) {
+int item = ring.pop(); // blocks only while the ring is empty
+std::cout << "Consumed: " << item << "\n";
+} else {
 std::unique_lock<std::mutex> lock(mtx); // lock buffer
 cv.wait(lock, [] { return !buffer.empty(); }); // wait if buffer empty
 int item = buffer.front(); // consume item
@@ -30,10 +155,13 @@ buffer.pop();
 std::cout << "Consumed: " << item << "\n";
 cv.notify_all(); // notify producer
 lock.unlock();
+}
 std::this_thread::sleep_for(std::chrono::milliseconds(150)); // simulate consumption time
 }
 }
-int main() {
+int main(int argc, char* argv[]) {
+use_ring = argc > 1 && std::string(argv[1]) == "--mpmc"; // lock-free ring instead of mutex + cv
+std::cout << "Buffer: " << (use_ring ? "lock-free MPMC ring" : "mutex + condition variable") << "\n";
 std::thread t1(producer); // producer thread
 std::thread t2(consumer); // consumer thread
 t1.join(); // wait for producer to finish
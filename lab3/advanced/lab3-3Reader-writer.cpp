@@ -1,7 +1,165 @@
 #include <iostream>
 #include <thread>
 #include <shared_mutex>
-std::shared_mutex rwLock; // allows multiple readers or single writer
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <climits>
+#include <type_traits>
+#include <sched.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+// Reader-writer lock with one reader counter per CPU, each on its own cache
+// line: a reader only touches the line of the CPU it runs on, so readers on
+// different CPUs never contend. Writers are rare and pay for it by summing
+// every counter. Same interface as std::shared_mutex.
+class DistributedRWLock {
+public:
+explicit DistributedRWLock(bool prefer_writers = true) : prefer_writers(prefer_writers) {
+unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+slot_count = 1;
+while (slot_count < cpus && slot_count < MAX_SLOTS) slot_count <<= 1;
+slots.reset(new Slot[slot_count]);
+}
+DistributedRWLock(const DistributedRWLock&) = delete;
+DistributedRWLock& operator=(const DistributedRWLock&) = delete;
+void lock_shared() {
+for (;;) {
+Slot& slot = mySlot();
+slot.readers.fetch_add(1); // seq_cst: pairs with the writer's flag store below
+if (writer.load() == 0) return; // no writer: done without touching a shared line
+slot.readers.fetch_sub(1); // back off so the writer can drain
+waitForWriter();
+}
+}
+bool try_lock_shared() {
+Slot& slot = mySlot();
+slot.readers.fetch_add(1);
+if (writer.load() == 0) return true;
+slot.readers.fetch_sub(1); // a writer holds or is claiming the lock
+return false;
+}
+void unlock_shared() {
+// May be a different slot than lock_shared used if the thread migrated;
+// only the sum over all slots matters
+mySlot().readers.fetch_sub(1, std::memory_order_release);
+}
+void lock() {
+writer_mutex.lock(); // one writer at a time
+for (;;) {
+writer.store(1); // seq_cst: new readers now see the flag and back off
+if (prefer_writers) { // keep the flag up and wait for current readers to leave
+while (readerCount() != 0) std::this_thread::yield();
+return;
+}
+if (readerCount() == 0) return;
+// Reader preference: step aside while readers are active, try again once they are gone
+releaseWriterFlag();
+while (readerCount() != 0) std::this_thread::yield();
+}
+}
+bool try_lock() {
+if (!writer_mutex.try_lock()) return false;
+writer.store(1);
+if (readerCount() == 0) return true;
+releaseWriterFlag(); // readers active: give up without waiting
+writer_mutex.unlock();
+return false;
+}
+void unlock() {
+releaseWriterFlag();
+writer_mutex.unlock();
+}
+private:
+static constexpr unsigned MAX_SLOTS = 64;
+struct alignas(64) Slot { std::atomic<int> readers{0}; }; // one cache line per CPU
+Slot& mySlot() {
+int cpu = sched_getcpu(); // vDSO call, a few ns
+return slots[static_cast<unsigned>(cpu < 0 ? 0 : cpu) & (slot_count - 1)];
+}
+int readerCount() {
+int total = 0; // counters of single slots can go negative after a migration
+for (unsigned i = 0; i < slot_count; i++) total += slots[i].readers.load();
+return total;
+}
+void waitForWriter() {
+for (int spin = 0; spin < 100; spin++) {
+if (writer.load(std::memory_order_acquire) == 0) return;
+std::this_thread::yield();
+}
+sleepers.fetch_add(1);
+while (writer.load() != 0) syscall(SYS_futex, reinterpret_cast<int*>(&writer), FUTEX_WAIT_PRIVATE, 1, nullptr, nullptr, 0);
+sleepers.fetch_sub(1);
+}
+void releaseWriterFlag() {
+writer.store(0); // seq_cst: a reader either sees 0 or has registered in sleepers
+if (sleepers.load() > 0) syscall(SYS_futex, reinterpret_cast<int*>(&writer), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+std::unique_ptr<Slot[]> slots;
+unsigned slot_count;
+bool prefer_writers; // true: a waiting writer blocks new readers, so writers never starve
+alignas(64) std::atomic<int> writer{0}; // 1 while a writer holds or is claiming the lock (futex word)
+std::atomic<int> sleepers{0}; // readers blocked in futex wait
+std::mutex writer_mutex;
+};
+// Sequence lock for tiny, trivially copyable records (a few words). Readers
+// take no lock at all: they copy the record and retry if a writer ran
+// meanwhile (odd or changed sequence). Writers never wait for readers, so
+// this suits data that is read constantly and updated rarely.
+// lab3-4.cpp keeps a copy of this class; fix both together.
+template <typename T>
+class SeqLock {
+static_assert(std::is_trivially_copyable<T>::value, "SeqLock copies T word by word");
+public:
+explicit SeqLock(const T& initial = T()) { store(initial); }
+T load() const {
+uint64_t buffer[WORDS];
+for (;;) {
+unsigned before = sequence.load(std::memory_order_acquire);
+if (before & 1) { std::this_thread::yield(); continue; } // write in progress
+for (size_t i = 0; i < WORDS; i++) buffer[i] = words[i].load(std::memory_order_relaxed);
+std::atomic_thread_fence(std::memory_order_acquire); // copy before re-reading the sequence
+if (sequence.load(std::memory_order_relaxed) == before) break;
+}
+T value;
+std::memcpy(&value, buffer, sizeof(T));
+return value;
+}
+void store(const T& value) {
+uint64_t buffer[WORDS] = {};
+std::memcpy(buffer, &value, sizeof(T));
+std::lock_guard<std::mutex> lock(writer_mutex); // writers still exclude each other
+unsigned seq = sequence.load(std::memory_order_relaxed);
+sequence.store(seq + 1, std::memory_order_relaxed); // odd: readers will retry
+std::atomic_thread_fence(std::memory_order_release);
+for (size_t i = 0; i < WORDS; i++) words[i].store(buffer[i], std::memory_order_relaxed);
+sequence.store(seq + 2, std::memory_order_release);
+}
+template <typename F>
+void update(F f) { // read-modify-write; updates are serialized
+std::lock_guard<std::mutex> lock(update_mutex);
+T value = load();
+f(value);
+store(value);
+}
+private:
+static constexpr size_t WORDS = (sizeof(T) + 7) / 8;
+// Words are atomics (relaxed) so racing reads are defined behaviour, not torn UB
+std::atomic<uint64_t> words[WORDS];
+alignas(64) std::atomic<unsigned> sequence{0};
+std::mutex writer_mutex;
+std::mutex update_mutex;
+};
+DistributedRWLock rwLock; // allows multiple readers or single writer
 int sharedData = 0; // shared data
 // Reader function
 void reader(int id) {
@@ -23,7 +181,98 @@ std::this_thread::sleep_for(std::chrono::milliseconds(300));
 }
 
 }
-int main() {
+// Small config record; every field always holds the same value, so a reader
+// seeing different values has observed a torn write
+struct Config { int64_t version, timeout, retries, limit; };
+// Operations/sec with `threads` threads doing reads with probability read_ratio
+// and otherwise bumping every field. Lock: anything with lock/unlock/lock_shared/unlock_shared.
+template <typename Lock>
+double rwThroughput(Lock& lock, int threads, double read_ratio, std::chrono::milliseconds window, bool& torn) {
+Config config{0, 0, 0, 0};
+std::atomic<bool> stop{false};
+std::atomic<long long> ops{0};
+std::atomic<bool> saw_torn{false};
+std::vector<std::thread> workers;
+for (int t = 0; t < threads; t++) {
+workers.emplace_back([&, t] {
+std::mt19937 gen(t + 1);
+std::uniform_real_distribution<> coin(0.0, 1.0);
+long long done = 0;
+while (!stop.load(std::memory_order_relaxed)) {
+if (coin(gen) < read_ratio) {
+lock.lock_shared();
+Config copy = config;
+lock.unlock_shared();
+if (copy.version != copy.limit) saw_torn = true;
+} else {
+lock.lock();
+config.version++; config.timeout++; config.retries++; config.limit++;
+lock.unlock();
+}
+done++;
+}
+ops += done;
+});
+}
+auto start = std::chrono::steady_clock::now();
+std::this_thread::sleep_for(window);
+stop = true;
+for (auto& w : workers) w.join();
+torn = saw_torn;
+return ops / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+// Same workload on a SeqLock-protected Config
+double seqThroughput(int threads, double read_ratio, std::chrono::milliseconds window, bool& torn) {
+SeqLock<Config> config(Config{0, 0, 0, 0});
+std::atomic<bool> stop{false};
+std::atomic<long long> ops{0};
+std::atomic<bool> saw_torn{false};
+std::vector<std::thread> workers;
+for (int t = 0; t < threads; t++) {
+workers.emplace_back([&, t] {
+std::mt19937 gen(t + 1);
+std::uniform_real_distribution<> coin(0.0, 1.0);
+long long done = 0;
+while (!stop.load(std::memory_order_relaxed)) {
+if (coin(gen) < read_ratio) {
+Config copy = config.load();
+if (copy.version != copy.limit) saw_torn = true;
+} else {
+config.update([](Config& c) { c.version++; c.timeout++; c.retries++; c.limit++; });
+}
+done++;
+}
+ops += done;
+});
+}
+auto start = std::chrono::steady_clock::now();
+std::this_thread::sleep_for(window);
+stop = true;
+for (auto& w : workers) w.join();
+torn = saw_torn;
+return ops / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+void benchmark(int threads) {
+const std::chrono::milliseconds window(300);
+std::cout << "Threads: " << threads << ", " << window.count() << "ms per run, ops/sec\n";
+std::cout << "Reads    shared_mutex   per-CPU (writer pref)   per-CPU (reader pref)   seqlock\n";
+for (double ratio : {0.50, 0.90, 0.99, 0.999}) {
+bool torn[4];
+std::shared_mutex shared;
+DistributedRWLock writer_pref(true), reader_pref(false);
+double a = rwThroughput(shared, threads, ratio, window, torn[0]);
+double b = rwThroughput(writer_pref, threads, ratio, window, torn[1]);
+double c = rwThroughput(reader_pref, threads, ratio, window, torn[2]);
+double d = seqThroughput(threads, ratio, window, torn[3]);
+std::printf("%5.1f%%   %12.0f   %21.0f   %21.0f   %9.0f%s\n", ratio * 100, a, b, c, d,
+torn[0] || torn[1] || torn[2] || torn[3] ? "   TORN READ" : "");
+}
+}
+int main(int argc, char* argv[]) {
+if (argc > 1 && std::string(argv[1]) == "--bench") { // --bench [threads]: read-ratio benchmark
+benchmark(argc > 2 ? std::atoi(argv[2]) : 8);
+return 0;
+}
 std::thread r1(reader, 1), r2(reader, 2), w1(writer, 1);
 r1.join(); r2.join(); w1.join();
 }
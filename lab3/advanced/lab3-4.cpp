@@ -1,24 +1,73 @@
 #include <iostream>
 #include <thread>
-#include <shared_mutex>
-std::shared_mutex rwLock; // allows multiple readers or single writer
-int sharedData = 0; // shared data
+#include <mutex>
+#include <atomic>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+// Sequence lock for tiny, trivially copyable records (a few words). Readers
+// take no lock at all: they copy the record and retry if a writer ran
+// meanwhile (odd or changed sequence). Writers never wait for readers, so
+// this suits data that is read constantly and updated rarely.
+// lab3-3Reader-writer.cpp keeps a copy of this class; fix both together.
+template <typename T>
+class SeqLock {
+static_assert(std::is_trivially_copyable<T>::value, "SeqLock copies T word by word");
+public:
+explicit SeqLock(const T& initial = T()) { store(initial); }
+T load() const {
+uint64_t buffer[WORDS];
+for (;;) {
+unsigned before = sequence.load(std::memory_order_acquire);
+if (before & 1) { std::this_thread::yield(); continue; } // write in progress
+for (size_t i = 0; i < WORDS; i++) buffer[i] = words[i].load(std::memory_order_relaxed);
+std::atomic_thread_fence(std::memory_order_acquire); // copy before re-reading the sequence
+if (sequence.load(std::memory_order_relaxed) == before) break;
+}
+T value;
+std::memcpy(&value, buffer, sizeof(T));
+return value;
+}
+void store(const T& value) {
+uint64_t buffer[WORDS] = {};
+std::memcpy(buffer, &value, sizeof(T));
+std::lock_guard<std::mutex> lock(writer_mutex); // writers still exclude each other
+unsigned seq = sequence.load(std::memory_order_relaxed);
+sequence.store(seq + 1, std::memory_order_relaxed); // odd: readers will retry
+std::atomic_thread_fence(std::memory_order_release);
+for (size_t i = 0; i < WORDS; i++) words[i].store(buffer[i], std::memory_order_relaxed);
+sequence.store(seq + 2, std::memory_order_release);
+}
+template <typename F>
+void update(F f) { // read-modify-write; updates are serialized
+std::lock_guard<std::mutex> lock(update_mutex);
+T value = load();
+f(value);
+store(value);
+}
+private:
+static constexpr size_t WORDS = (sizeof(T) + 7) / 8;
+// Words are atomics (relaxed) so racing reads are defined behaviour, not torn UB
+std::atomic<uint64_t> words[WORDS];
+alignas(64) std::atomic<unsigned> sequence{0};
+std::mutex writer_mutex;
+std::mutex update_mutex;
+};
+SeqLock<int> sharedData(0); // readers never block, writers never wait for readers
 // Reader function
 void reader(int id) {
 for (int i = 0; i < 3; i++) {
-rwLock.lock_shared(); // shared lock allows multiple readers
-std::cout << "Reader " << id << " read data = " << sharedData << "\n";
-rwLock.unlock_shared();
+int value = sharedData.load(); // lock-free snapshot, retried if a write overlapped
+std::cout << "Reader " << id << " read data = " << value << "\n";
 std::this_thread::sleep_for(std::chrono::milliseconds(200));
 }
 }
 // Writer function
 void writer(int id) {
 for (int i = 0; i < 3; i++) {
-rwLock.lock(); // exclusive lock for writing
-sharedData += 10;
-std::cout << "Writer " << id << " updated data = " << sharedData << "\n";
-rwLock.unlock();
+int value = 0;
+sharedData.update([&value](int& data) { data += 10; value = data; }); // exclusive among writers
+std::cout << "Writer " << id << " updated data = " << value << "\n";
 std::this_thread::sleep_for(std::chrono::milliseconds(300));
 }
 
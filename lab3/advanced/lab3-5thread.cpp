@@ -1,45 +1,304 @@
+// Requires C++17 (if constexpr, std::invoke_result_t, std::is_same_v)
+// Compile: g++ -std=c++17 -pthread lab3-5thread.cpp -o lab3-5thread
 #include <iostream>
 #include <thread>
-#include <queue>
+#include <deque>
 #include <vector>
 #include <mutex>
 #include <condition_variable>
 #include <functional>
 #include <atomic>
-std::queue<std::function<void()>> tasks; // task queue
-std::mutex mtx; // mutex for queue
-std::condition_variable cv; // condition variable
-std::atomic<bool> done(false); // flag to stop threads
-// Worker thread function
-void worker(int id) {
-while (!done) {
-std::function<void()> task;
+#include <future>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+// Move-only callable that keeps small captures in an inline buffer
+// instead of heap-allocating like std::function does
+class InlineTask {
+public:
+static constexpr size_t CAPACITY = 48; // bytes of capture kept inline
+InlineTask() = default;
+template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineTask>>>
+InlineTask(F&& f) {
+using T = std::decay_t<F>;
+if constexpr (sizeof(T) <= CAPACITY && alignof(T) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<T>) {
+new (storage) T(std::forward<F>(f)); // small capture: store in place
+ops = &inlineOps<T>;
+} else {
+new (storage) T*(new T(std::forward<F>(f))); // large capture: store a pointer
+ops = &heapOps<T>;
+}
+}
+InlineTask(InlineTask&& other) noexcept : ops(other.ops) {
+if (ops) ops->move(storage, other.storage);
+other.ops = nullptr;
+}
+InlineTask& operator=(InlineTask&& other) noexcept {
+if (this != &other) {
+reset();
+ops = other.ops;
+if (ops) ops->move(storage, other.storage);
+other.ops = nullptr;
+}
+return *this;
+}
+InlineTask(const InlineTask&) = delete;
+InlineTask& operator=(const InlineTask&) = delete;
+~InlineTask() { reset(); }
+void operator()() { ops->invoke(storage); }
+explicit operator bool() const { return ops != nullptr; }
+private:
+struct Ops {
+void (*invoke)(void*);
+void (*move)(void* dst, void* src); // move-construct into dst and destroy src
+void (*destroy)(void*);
+};
+template <typename T>
+static constexpr Ops inlineOps = {
+[](void* p) { (*static_cast<T*>(p))(); },
+[](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); static_cast<T*>(src)->~T(); },
+[](void* p) { static_cast<T*>(p)->~T(); }
+};
+template <typename T>
+static constexpr Ops heapOps = {
+[](void* p) { (**static_cast<T**>(p))(); },
+[](void* dst, void* src) { new (dst) T*(*static_cast<T**>(src)); },
+[](void* p) { delete *static_cast<T**>(p); }
+};
+void reset() {
+if (ops) ops->destroy(storage);
+ops = nullptr;
+}
+alignas(std::max_align_t) unsigned char storage[CAPACITY];
+const Ops* ops = nullptr;
+};
+// What a bounded pool does when the queue is full
+enum class OverflowPolicy {
+Block, // wait for space
+Reject // refuse the task (post returns false, submit throws)
+};
+// Fixed-size thread pool with an optionally bounded queue
+class ThreadPool {
+public:
+explicit ThreadPool(size_t threads = std::thread::hardware_concurrency(), size_t capacity = 0,
+OverflowPolicy policy = OverflowPolicy::Block)
+: capacity(capacity), policy(policy) {
+thread_count = std::max<size_t>(threads, 1);
+for (size_t i = 0; i < thread_count; i++)
+workers.emplace_back(&ThreadPool::worker, this);
+}
+~ThreadPool() { shutdown(true); }
+ThreadPool(const ThreadPool&) = delete;
+ThreadPool& operator=(const ThreadPool&) = delete;
+// Fire-and-forget: no future, so a small task never touches the heap.
+// Returns false if the task was rejected (queue full under Reject, or shut down)
+template <typename F>
+bool post(F&& f) {
+std::unique_lock<std::mutex> lock(mtx);
+if (!waitForSpace(lock, 1)) return false;
+queue.emplace_back(std::forward<F>(f));
+notifyWorkers(lock, 1);
+return true;
+}
+// Runs f(args...) on the pool; the future carries its result or exception
+template <typename F, typename... Args>
+auto submit(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+using R = std::invoke_result_t<F, Args...>;
+std::packaged_task<R()> task(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+std::future<R> result = task.get_future();
+if (!post(std::move(task))) throw std::runtime_error("ThreadPool: task rejected");
+return result;
+}
+// Enqueues f(0) .. f(count-1) under a single lock with a single wake-up.
+// The future completes once all have run and carries the first exception, if any.
+// A bounded pool takes the batch in capacity-sized pieces under Block and rejects
+// it whole under Reject.
+template <typename F>
+std::future<void> submit_bulk(size_t count, F f) {
+struct Batch {
+F f;
+std::atomic<size_t> remaining;
+std::promise<void> done;
+std::once_flag error_once;
+std::exception_ptr error;
+Batch(F fn, size_t n) : f(std::move(fn)), remaining(n) {}
+};
+auto batch = std::make_shared<Batch>(std::move(f), count);
+std::future<void> result = batch->done.get_future();
+if (count == 0) {
+batch->done.set_value();
+return result;
+}
+size_t next = 0;
+std::unique_lock<std::mutex> lock(mtx);
+if (capacity > 0 && policy == OverflowPolicy::Reject && queue.size() + count > capacity)
+throw std::runtime_error("ThreadPool: batch rejected");
+while (next < count) {
+if (!waitForSpace(lock, 1)) throw std::runtime_error("ThreadPool: batch rejected");
+size_t room = capacity > 0 ? capacity - queue.size() : count - next;
+size_t end = next + std::min(room, count - next);
+for (size_t i = next; i < end; i++) {
+queue.emplace_back([batch, i] {
+try {
+batch->f(i);
+} catch (...) {
+std::call_once(batch->error_once, [&] { batch->error = std::current_exception(); });
+}
+if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+if (batch->error) batch->done.set_exception(batch->error);
+else batch->done.set_value();
+}
+});
+}
+notifyWorkers(lock, end - next);
+next = end;
+if (next < count) lock.lock(); // the rest did not fit; wait for workers to make room
+}
+return result;
+}
+// Blocks until the queue is empty and no task is running
+void wait_idle() {
+std::unique_lock<std::mutex> lock(mtx);
+idle_cv.wait(lock, [this] { return queue.empty() && active == 0; });
+}
+// Stops accepting tasks and joins the workers. With drain, everything already
+// queued runs first; without it, tasks no worker has picked up yet are dropped
+// (their futures report broken_promise).
+void shutdown(bool drain = true) {
+{
+std::lock_guard<std::mutex> lock(mtx);
+if (stopping && workers.empty()) return;
+stopping = true;
+if (!drain) queue.clear();
+}
+not_empty.notify_all();
+not_full.notify_all();
+for (auto& t : workers)
+if (t.joinable()) t.join();
+workers.clear();
+}
+size_t pending() {
+std::lock_guard<std::mutex> lock(mtx);
+return queue.size();
+}
+private:
+static constexpr size_t MAX_BATCH = 64; // tasks a worker takes per lock acquisition
+// Caller holds the lock. Under Block waits until needed slots are free;
+// returns false if the task must be rejected
+bool waitForSpace(std::unique_lock<std::mutex>& lock, size_t needed) {
+if (stopping) return false;
+if (capacity == 0 || queue.size() + needed <= capacity) return true;
+if (policy == OverflowPolicy::Reject) return false;
+waiting_producers++;
+not_full.wait(lock, [&] { return stopping || queue.size() + needed <= capacity; });
+waiting_producers--;
+return !stopping;
+}
+// Releases the lock, then wakes only as many sleeping workers as there is new work.
+// Workers already signalled but not yet running are not woken twice.
+void notifyWorkers(std::unique_lock<std::mutex>& lock, size_t added) {
+size_t unsignalled = idle_workers > wakeups_pending ? idle_workers - wakeups_pending : 0;
+size_t wake = std::min(added, unsignalled);
+wakeups_pending += wake;
+lock.unlock();
+if (wake == 0) return;
+if (wake == unsignalled) not_empty.notify_all();
+else for (size_t i = 0; i < wake; i++) not_empty.notify_one();
+}
+void worker() {
+std::vector<InlineTask> batch;
+batch.reserve(MAX_BATCH);
+size_t finished = 0;
+for (;;) {
 {
 std::unique_lock<std::mutex> lock(mtx);
-
-cv.wait(lock, []{ return !tasks.empty() || done; }); // wait for task
-if (done && tasks.empty()) break;
-task = tasks.front();
-tasks.pop();
+active -= finished; // account for the previous batch under the same lock
+if (active == 0 && queue.empty()) idle_cv.notify_all();
+while (queue.empty() && !stopping) {
+idle_workers++;
+not_empty.wait(lock);
+idle_workers--;
+if (wakeups_pending > 0) wakeups_pending--; // this wake-up was (probably) ours
+}
+if (queue.empty()) break; // stopping and fully drained
+// Take a fair share of the backlog so one lock round-trip covers several tasks
+size_t take = std::min({queue.size(), queue.size() / thread_count + 1, MAX_BATCH});
+for (size_t i = 0; i < take; i++) {
+batch.push_back(std::move(queue.front()));
+queue.pop_front();
 }
-std::cout << "Worker " << id << " executing task\n";
+active += take;
+if (waiting_producers > 0) not_full.notify_all(); // room for blocked producers
+}
+for (auto& task : batch) {
+try {
 task();
+} catch (const std::exception& e) {
+std::cerr << "ThreadPool: task threw: " << e.what() << "\n"; // submit() tasks report through their future instead
+} catch (...) {
+std::cerr << "ThreadPool: task threw\n";
+}
 }
+finished = batch.size();
+batch.clear();
 }
+}
+std::vector<std::thread> workers;
+size_t thread_count; // fixed before the workers start, unlike workers.size()
+std::deque<InlineTask> queue; // task queue
+std::mutex mtx; // mutex for queue
+std::condition_variable not_empty; // workers wait for tasks
+std::condition_variable not_full; // producers wait for space (Block policy)
+std::condition_variable idle_cv; // wait_idle waits for the drain
+size_t capacity; // 0 = unbounded
+OverflowPolicy policy;
+size_t active = 0; // tasks taken by workers but not yet finished
+size_t idle_workers = 0; // workers blocked on not_empty
+size_t wakeups_pending = 0; // notifications sent but not yet picked up
+size_t waiting_producers = 0;
+bool stopping = false; // flag to stop accepting tasks
+};
 int main() {
 const int THREADS = 3;
-std::vector<std::thread> pool;
-// create worker threads
-for (int i = 0; i < THREADS; i++)
-pool.emplace_back(worker, i+1);
-// add tasks to the queue
-for (int i = 1; i <= 6; i++) {
-std::lock_guard<std::mutex> lock(mtx);
-tasks.push([i]{ std::cout << "Task " << i << " done\n"; });
-cv.notify_one(); // wake a worker
+ThreadPool pool(THREADS);
+// add tasks to the pool; each future carries the task's result
+std::vector<std::future<int>> results;
+for (int i = 1; i <= 6; i++)
+results.push_back(pool.submit([i] {
+std::cout << "Task " << i << " done\n";
+return i * i;
+}));
+for (int i = 1; i <= 6; i++)
+std::cout << "Task " << i << " returned " << results[i - 1].get() << "\n";
+// bounded queue: reject overflow instead of growing without limit
+{
+ThreadPool bounded(1, 2, OverflowPolicy::Reject);
+int accepted = 0, rejected = 0;
+for (int i = 0; i < 10; i++) {
+if (bounded.post([] { std::this_thread::sleep_for(std::chrono::milliseconds(20)); })) accepted++;
+else rejected++;
 }
-std::this_thread::sleep_for(std::chrono::seconds(1));
-done = true; // signal threads to exit
-cv.notify_all(); // wake all workers
-for (auto& t : pool) t.join();
+std::cout << "Bounded pool (capacity 2, reject): accepted " << accepted << ", rejected " << rejected << "\n";
+} // destructor drains the accepted tasks before joining
+// throughput with small captures that stay inline; post() takes the lock and
+// may wake a worker per task, so only submit_bulk() reaches ~10M tasks/sec
+const size_t COUNT = 10000000;
+std::atomic<size_t> counter(0);
+auto start = std::chrono::steady_clock::now();
+for (size_t i = 0; i < COUNT; i++)
+pool.post([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+pool.wait_idle();
+double single = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+start = std::chrono::steady_clock::now();
+pool.submit_bulk(COUNT, [&counter](size_t) { counter.fetch_add(1, std::memory_order_relaxed); }).get();
+double bulk = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+std::cout << "post():        " << static_cast<size_t>(COUNT / single) << " tasks/sec\n";
+std::cout << "submit_bulk(): " << static_cast<size_t>(COUNT / bulk) << " tasks/sec\n";
+std::cout << "Tasks run: " << counter.load() << "\n";
+pool.shutdown(); // graceful drain, then join
 }
@@ -6,6 +6,18 @@
 #include <queue>
 #include <algorithm>
 #include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 struct Process {
     int pid;
@@ -22,12 +34,220 @@ struct Process {
           remaining_time(bt), priority(pr) {}
 };
 
+// Streams Process records from a trace file in fixed-size chunks.
+// CSV traces hold "pid,arrival,burst[,priority]" lines (lines starting with a
+// letter or '#' are skipped as headers/comments); binary traces start with
+// MAGIC followed by packed little-endian int32 records of the same four fields.
+// Each lab file builds on its own, so lab4-3.cpp keeps a copy of this reader;
+// a fix to one belongs in the other as well.
+class TraceReader {
+public:
+    static constexpr char MAGIC[8] = {'P', 'R', 'O', 'C', 'T', 'R', 'C', '1'};
+    static constexpr size_t RECORD_SIZE = 4 * sizeof(int32_t);
+    static constexpr size_t CHUNK_SIZE = 1 << 20;
+
+private:
+    std::ifstream file;
+    std::vector<char> buffer;
+    size_t begin = 0;
+    size_t end = 0;
+    bool binary = false;
+    long long records = 0;
+    long long line_number = 0;   // CSV line, or binary record, last read
+    
+    // Move the unread tail to the front and append the next chunk
+    bool refill() {
+        if (!file) return false;
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+        file.read(buffer.data() + end, static_cast<std::streamsize>(buffer.size() - end));
+        end += static_cast<size_t>(file.gcount());
+        return file.gcount() > 0;
+    }
+    
+    static int32_t decodeInt32(const char* bytes) {
+        uint32_t value = 0;
+        for (int i = 3; i >= 0; i--) {
+            value = (value << 8) | static_cast<unsigned char>(bytes[i]);
+        }
+        return static_cast<int32_t>(value);
+    }
+    
+    // A negative arrival or a burst <= 0 would run the simulated clock backwards
+    // or break the per-process metrics
+    static void checkRange(const Process& p, const std::string& where) {
+        if (p.arrival_time < 0 || p.burst_time <= 0) {
+            throw std::runtime_error("Out-of-range trace record on " + where +
+                                     " (arrival must be >= 0 and burst > 0)");
+        }
+    }
+    
+    bool nextBinary(Process& p) {
+        if (end - begin < RECORD_SIZE && !refill() && begin == end) return false;
+        if (end - begin < RECORD_SIZE) {
+            throw std::runtime_error("Truncated binary trace record");
+        }
+        const char* rec = buffer.data() + begin;
+        p = Process(decodeInt32(rec), decodeInt32(rec + 4), decodeInt32(rec + 8), decodeInt32(rec + 12));
+        begin += RECORD_SIZE;
+        line_number++;
+        checkRange(p, "record " + std::to_string(line_number));
+        return true;
+    }
+    
+    bool nextCSV(Process& p) {
+        while (true) {
+            const char* first = buffer.data() + begin;
+            const char* newline = static_cast<const char*>(std::memchr(first, '\n', end - begin));
+            if (!newline) {
+                if (end - begin == buffer.size()) {
+                    throw std::runtime_error("Trace line exceeds chunk size");
+                }
+                if (refill()) continue;
+                if (begin == end) return false;
+                newline = buffer.data() + end; // last line without a trailing newline
+            }
+            const char* last = newline;
+            begin = std::min(end, static_cast<size_t>(newline - buffer.data()) + 1);
+            line_number++;
+            
+            if (last > first && last[-1] == '\r') last--;
+            if (first == last || std::isalpha(static_cast<unsigned char>(*first)) || *first == '#') {
+                continue;
+            }
+            
+            int fields[4] = {0, 0, 0, 0};
+            int count = 0;
+            for (const char* cur = first; count < 4; count++) {
+                while (cur < last && *cur == ' ') cur++;
+                auto [ptr, ec] = std::from_chars(cur, last, fields[count]);
+                if (ec != std::errc()) break;
+                cur = ptr;
+                while (cur < last && *cur == ' ') cur++;
+                if (cur == last || *cur != ',') { count++; break; }
+                cur++;
+            }
+            if (count < 3) {
+                throw std::runtime_error("Malformed trace record on line " + std::to_string(line_number));
+            }
+            p = Process(fields[0], fields[1], fields[2], fields[3]);
+            checkRange(p, "line " + std::to_string(line_number));
+            return true;
+        }
+    }
+
+public:
+    explicit TraceReader(const std::string& path, size_t chunk_size = CHUNK_SIZE)
+        : file(path, std::ios::binary), buffer(std::max(chunk_size, sizeof(MAGIC))) {
+        if (!file) {
+            throw std::runtime_error("Cannot open trace file: " + path);
+        }
+        refill();
+        binary = end >= sizeof(MAGIC) && std::memcmp(buffer.data(), MAGIC, sizeof(MAGIC)) == 0;
+        if (binary) begin = sizeof(MAGIC);
+    }
+    
+    bool next(Process& p) {
+        if (!(binary ? nextBinary(p) : nextCSV(p))) return false;
+        records++;
+        return true;
+    }
+    
+    bool isBinary() const { return binary; }
+    long long recordsRead() const { return records; }
+};
+
+// Sum of a contiguous int32 column into 64 bits. The SSE2 path sign-extends four
+// values at a time into two 64-bit lane pairs; other targets use four independent
+// scalar accumulators so the compiler can pipeline (or vectorize) the loop.
+int64_t sumColumn(const int32_t* values, size_t count) {
+    size_t i = 0;
+    int64_t total = 0;
+#if defined(__SSE2__)
+    __m128i acc_lo = _mm_setzero_si128();
+    __m128i acc_hi = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        __m128i sign = _mm_srai_epi32(v, 31);
+        acc_lo = _mm_add_epi64(acc_lo, _mm_unpacklo_epi32(v, sign));
+        acc_hi = _mm_add_epi64(acc_hi, _mm_unpackhi_epi32(v, sign));
+    }
+    alignas(16) int64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi64(acc_lo, acc_hi));
+    total = lanes[0] + lanes[1];
+#else
+    int64_t acc[4] = {0, 0, 0, 0};
+    for (; i + 4 <= count; i += 4) {
+        acc[0] += values[i];
+        acc[1] += values[i + 1];
+        acc[2] += values[i + 2];
+        acc[3] += values[i + 3];
+    }
+    total = acc[0] + acc[1] + acc[2] + acc[3];
+#endif
+    for (; i < count; i++) {
+        total += values[i];
+    }
+    return total;
+}
+
+// Structure-of-arrays process table: every field is its own contiguous array,
+// so a pass over one metric only pulls that metric's cache lines.
+class ProcessTable {
+public:
+    std::vector<int32_t> pid;
+    std::vector<int32_t> arrival_time;
+    std::vector<int32_t> burst_time;
+    std::vector<int32_t> remaining_time;
+    std::vector<int32_t> completion_time;
+    std::vector<int32_t> turnaround_time;
+    std::vector<int32_t> waiting_time;
+    std::vector<int32_t> priority;
+    
+    void add(int id, int arrival, int burst, int prio = 0) {
+        pid.push_back(id);
+        arrival_time.push_back(arrival);
+        burst_time.push_back(burst);
+        remaining_time.push_back(burst);
+        completion_time.push_back(0);
+        turnaround_time.push_back(0);
+        waiting_time.push_back(0);
+        priority.push_back(prio);
+    }
+    
+    void reserve(size_t n) {
+        for (auto* column : {&pid, &arrival_time, &burst_time, &remaining_time,
+                             &completion_time, &turnaround_time, &waiting_time, &priority}) {
+            column->reserve(n);
+        }
+    }
+    
+    size_t size() const { return pid.size(); }
+    
+    bool empty() const { return pid.empty(); }
+    
+    double average(const std::vector<int32_t>& column) const {
+        if (column.empty()) return 0.0;
+        return static_cast<double>(sumColumn(column.data(), column.size())) / column.size();
+    }
+};
+
 class ProcessScheduler {
 public:
-    std::vector<Process> processes;
+    ProcessTable processes;
     
     void addProcess(int pid, int arrival, int burst, int priority = 0) {
-        processes.emplace_back(pid, arrival, burst, priority);
+        processes.add(pid, arrival, burst, priority);
+    }
+    
+    // Stream processes from a CSV or binary trace file (see TraceReader)
+    void loadTrace(const std::string& path) {
+        TraceReader reader(path);
+        Process p(0, 0, 0);
+        while (reader.next(p)) {
+            addProcess(p.pid, p.arrival_time, p.burst_time, p.priority);
+        }
     }
     
     void displayProcesses() {
@@ -36,39 +256,104 @@ public:
                   << std::setw(12) << "Turnaround" << std::setw(10) << "Waiting\n";
         std::cout << std::string(60, '-') << "\n";
         
-        for (const auto& p : processes) {
-            std::cout << std::setw(5) << p.pid << std::setw(10) << p.arrival_time
-                      << std::setw(10) << p.burst_time << std::setw(12) << p.completion_time
-                      << std::setw(12) << p.turnaround_time << std::setw(10) << p.waiting_time << "\n";
+        for (size_t i = 0; i < processes.size(); i++) {
+            std::cout << std::setw(5) << processes.pid[i] << std::setw(10) << processes.arrival_time[i]
+                      << std::setw(10) << processes.burst_time[i] << std::setw(12) << processes.completion_time[i]
+                      << std::setw(12) << processes.turnaround_time[i] << std::setw(10) << processes.waiting_time[i] << "\n";
         }
     }
     
     double calculateAverageWaitingTime() {
-        int total = 0;
-        for (const auto& p : processes) {
-            total += p.waiting_time;
-        }
-        return static_cast<double>(total) / processes.size();
+        return processes.average(processes.waiting_time);
     }
     
     double calculateAverageTurnaroundTime() {
-        int total = 0;
-        for (const auto& p : processes) {
-            total += p.turnaround_time;
-        }
-        return static_cast<double>(total) / processes.size();
+        return processes.average(processes.turnaround_time);
     }
 };
 
+// Compare the AoS metric loops with the SoA column kernel on `count` processes
+void benchmarkLayouts(size_t count) {
+    std::vector<Process> aos;
+    ProcessTable soa;
+    aos.reserve(count);
+    soa.reserve(count);
+    
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int arrival = static_cast<int>(i);
+        int burst = 1 + static_cast<int>(seed >> 28);
+        int waiting = static_cast<int>((seed >> 8) & 0xFFFF);
+        
+        Process p(static_cast<int>(i), arrival, burst);
+        p.completion_time = arrival + waiting + burst;
+        p.turnaround_time = waiting + burst;
+        p.waiting_time = waiting;
+        aos.push_back(p);
+        
+        soa.add(p.pid, p.arrival_time, p.burst_time, p.priority);
+        soa.completion_time.back() = p.completion_time;
+        soa.turnaround_time.back() = p.turnaround_time;
+        soa.waiting_time.back() = p.waiting_time;
+    }
+    
+    auto time = [](auto&& body) {
+        constexpr int ROUNDS = 10;
+        double result = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < ROUNDS; r++) result += body();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(result / ROUNDS, ms / ROUNDS);
+    };
+    
+    auto [aos_avg, aos_ms] = time([&]() {
+        int64_t waiting = 0, turnaround = 0;
+        for (const auto& p : aos) {
+            waiting += p.waiting_time;
+            turnaround += p.turnaround_time;
+        }
+        return static_cast<double>(waiting + turnaround) / aos.size();
+    });
+    auto [soa_avg, soa_ms] = time([&]() {
+        return soa.average(soa.waiting_time) + soa.average(soa.turnaround_time);
+    });
+    
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Processes: " << count << "\n";
+    std::cout << "AoS waiting+turnaround averages: " << aos_ms << " ms (result " << aos_avg << ")\n";
+    std::cout << "SoA waiting+turnaround averages: " << soa_ms << " ms (result " << soa_avg << ")\n";
+    std::cout << "Speedup: " << aos_ms / soa_ms << "x\n";
+}
+
 // Demo main function
-int main() {
+// Usage: process_basics [trace.csv|trace.bin] loads the processes from a trace
+//        process_basics --bench [count] compares AoS and SoA metric passes (default 10^7)
+int main(int argc, char* argv[]) {
     ProcessScheduler scheduler;
     
-    // Example processes
-    scheduler.addProcess(1, 0, 7);
-    scheduler.addProcess(2, 2, 4);
-    scheduler.addProcess(3, 4, 1);
-    scheduler.addProcess(4, 5, 4);
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        size_t count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000000;
+        std::cout << "AoS vs SoA Metrics Benchmark\n";
+        std::cout << "============================\n";
+        benchmarkLayouts(count);
+        return 0;
+    }
+    
+    if (argc > 1) {
+        try {
+            scheduler.loadTrace(argv[1]);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    } else {
+        // Example processes
+        scheduler.addProcess(1, 0, 7);
+        scheduler.addProcess(2, 2, 4);
+        scheduler.addProcess(3, 4, 1);
+        scheduler.addProcess(4, 5, 4);
+    }
     
     std::cout << "Basic Process Structure Demo\n";
     std::cout << "============================\n";
@@ -4,7 +4,11 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <random>
 #include <iomanip>
+#include <cmath>
+#include <cstdint>
+#include <optional>
 
 struct Process {
     int pid;
@@ -21,59 +25,155 @@ struct Process {
           remaining_time(bt), priority(pr) {}
 };
 
-class MetricsCalculator {
+// Running count, mean and variance (Welford's method), updated in O(1) per sample
+class RunningStats {
 private:
-    std::vector<Process> processes;
-    int total_time;
-    int cpu_idle_time;
+    long long n = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
 
 public:
-    void setProcesses(const std::vector<Process>& procs) {
-        processes = procs;
-        calculateTotalTime();
+    void add(double x) {
+        n++;
+        double delta = x - mean;
+        mean += delta / n;
+        m2 += delta * (x - mean);
     }
     
-    void calculateTotalTime() {
-        if (processes.empty()) return;
-        
-        int max_completion = 0;
-        for (const auto& p : processes) {
-            max_completion = std::max(max_completion, p.completion_time);
-        }
-        total_time = max_completion;
+    long long count() const { return n; }
+    double getMean() const { return mean; }
+    double getVariance() const { return n > 1 ? m2 / (n - 1) : 0.0; }
+    double getStdDev() const { return std::sqrt(getVariance()); }
+};
+
+// HDR-style histogram for streaming percentiles. Values below 2^SUB_BUCKET_BITS
+// are counted exactly; larger values share 2^SUB_BUCKET_BITS buckets per power
+// of two, so any reported percentile is within 1% of the true value.
+class LatencyHistogram {
+private:
+    static constexpr int SUB_BUCKET_BITS = 7;
+    static constexpr uint64_t SUB_BUCKETS = uint64_t(1) << SUB_BUCKET_BITS;
+    
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    uint64_t max_value = 0;
+    
+    static size_t bucketIndex(uint64_t value) {
+        if (value < SUB_BUCKETS) return static_cast<size_t>(value);
+        int shift = (63 - __builtin_clzll(value)) - SUB_BUCKET_BITS;
+        return static_cast<size_t>(shift * SUB_BUCKETS + (value >> shift));
     }
     
-    double getCPUUtilization() {
-        int cpu_busy_time = total_time - cpu_idle_time;
-        return (static_cast<double>(cpu_busy_time) / total_time) * 100.0;
+    static uint64_t bucketUpperBound(size_t index) {
+        if (index < 2 * SUB_BUCKETS) return index;
+        int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+        uint64_t mantissa = index - shift * SUB_BUCKETS;
+        return ((mantissa + 1) << shift) - 1;
     }
+
+public:
+    LatencyHistogram() : counts((64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS, 0) {}
     
-    double getThroughput() {
-        return static_cast<double>(processes.size()) / total_time;
+    void record(long long value) {
+        uint64_t v = value > 0 ? static_cast<uint64_t>(value) : 0;
+        counts[bucketIndex(v)]++;
+        total++;
+        max_value = std::max(max_value, v);
     }
     
-    double getAverageWaitingTime() {
-        int total_waiting = 0;
-        for (const auto& p : processes) {
-            total_waiting += p.waiting_time;
+    // Upper bound of the bucket holding the percentile-th sample, capped at the
+    // largest recorded value: at least the true percentile, and within 1% of it
+    uint64_t getPercentile(double percentile) const {
+        if (total == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * total));
+        rank = std::max<uint64_t>(rank, 1);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); i++) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(bucketUpperBound(i), max_value);
         }
-        return static_cast<double>(total_waiting) / processes.size();
+        return max_value;
+    }
+};
+
+// Online scheduling metrics: the scheduler calls recordCompletion() on every
+// completion event, and every getter is answered without rescanning processes.
+class MetricsCalculator {
+private:
+    long long completed = 0;
+    int total_time = 0;
+    long long cpu_busy_time = 0;
+    std::optional<int> cpu_idle_time;
+    
+    RunningStats waiting;
+    RunningStats turnaround;
+    LatencyHistogram waiting_histogram;
+    LatencyHistogram turnaround_histogram;
+
+public:
+    void reset() { *this = MetricsCalculator(); } // Also forgets the idle time
+    
+    void recordCompletion(const Process& p) {
+        completed++;
+        total_time = std::max(total_time, p.completion_time);
+        cpu_busy_time += p.burst_time;
+        
+        waiting.add(p.waiting_time);
+        turnaround.add(p.turnaround_time);
+        waiting_histogram.record(p.waiting_time);
+        turnaround_histogram.record(p.turnaround_time);
     }
     
-    double getAverageTurnaroundTime() {
-        int total_turnaround = 0;
-        for (const auto& p : processes) {
-            total_turnaround += p.turnaround_time;
+    // Replaces the recorded completions; an idle time set with setCPUIdleTime()
+    // is kept, so the two can be called in either order
+    void setProcesses(const std::vector<Process>& procs) {
+        std::optional<int> idle = cpu_idle_time;
+        reset();
+        cpu_idle_time = idle;
+        for (const auto& p : procs) {
+            recordCompletion(p);
         }
-        return static_cast<double>(total_turnaround) / processes.size();
     }
     
-    double getAverageResponseTime() {
+    int getTotalTime() const { return total_time; }
+    
+    long long getCompletedCount() const { return completed; }
+    
+    // Uses the idle time given to setCPUIdleTime(), or otherwise treats every
+    // unit not spent on a completed burst as idle
+    double getCPUUtilization() const {
+        if (total_time == 0) return 0.0;
+        long long busy = cpu_idle_time ? total_time - *cpu_idle_time : cpu_busy_time;
+        return (static_cast<double>(busy) / total_time) * 100.0;
+    }
+    
+    double getThroughput() const {
+        if (total_time == 0) return 0.0;
+        return static_cast<double>(completed) / total_time;
+    }
+    
+    double getAverageWaitingTime() const { return waiting.getMean(); }
+    
+    double getAverageTurnaroundTime() const { return turnaround.getMean(); }
+    
+    double getAverageResponseTime() const {
         // Assuming response time equals waiting time for simplicity
         return getAverageWaitingTime();
     }
     
-    void displayMetrics() {
+    double getWaitingTimeStdDev() const { return waiting.getStdDev(); }
+    
+    double getTurnaroundTimeStdDev() const { return turnaround.getStdDev(); }
+    
+    uint64_t getWaitingTimePercentile(double percentile) const {
+        return waiting_histogram.getPercentile(percentile);
+    }
+    
+    uint64_t getTurnaroundTimePercentile(double percentile) const {
+        return turnaround_histogram.getPercentile(percentile);
+    }
+    
+    void displayMetrics() const {
         std::cout << std::fixed << std::setprecision(2);
         std::cout << "\n=== SCHEDULING METRICS ===\n";
         std::cout << "CPU Utilization: " << getCPUUtilization() << "%\n";
@@ -81,6 +181,12 @@ public:
         std::cout << "Average Waiting Time: " << getAverageWaitingTime() << " units\n";
         std::cout << "Average Turnaround Time: " << getAverageTurnaroundTime() << " units\n";
         std::cout << "Average Response Time: " << getAverageResponseTime() << " units\n";
+        std::cout << "Waiting Time Std Dev: " << getWaitingTimeStdDev() << " units\n";
+        std::cout << "Turnaround Time Std Dev: " << getTurnaroundTimeStdDev() << " units\n";
+        std::cout << "Waiting Time p50/p95/p99: " << getWaitingTimePercentile(50) << " / "
+                  << getWaitingTimePercentile(95) << " / " << getWaitingTimePercentile(99) << " units\n";
+        std::cout << "Turnaround Time p50/p95/p99: " << getTurnaroundTimePercentile(50) << " / "
+                  << getTurnaroundTimePercentile(95) << " / " << getTurnaroundTimePercentile(99) << " units\n";
     }
     
     void setCPUIdleTime(int idle) { cpu_idle_time = idle; }
@@ -110,5 +216,30 @@ int main() {
     calc.setCPUIdleTime(0);
     calc.displayMetrics();
     
+    // Live metrics: feed completion events one at a time, as a scheduler would
+    std::cout << "\n=== LIVE METRICS (1,000,000 FCFS completions) ===\n";
+    MetricsCalculator live;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> gap_dist(0, 12);
+    std::uniform_int_distribution<> burst_dist(1, 10);
+    int clock = 0;
+    int arrival = 0;
+    for (int pid = 1; pid <= 1000000; pid++) {
+        arrival += gap_dist(gen);
+        Process p(pid, arrival, burst_dist(gen));
+        clock = std::max(clock, arrival) + p.burst_time;
+        p.completion_time = clock;
+        p.turnaround_time = p.completion_time - p.arrival_time;
+        p.waiting_time = p.turnaround_time - p.burst_time;
+        live.recordCompletion(p);
+        
+        if (pid % 250000 == 0) {
+            std::cout << "After " << live.getCompletedCount() << " completions: throughput "
+                      << live.getThroughput() << ", CPU " << live.getCPUUtilization()
+                      << "%, p99 waiting " << live.getWaitingTimePercentile(99) << "\n";
+        }
+    }
+    live.displayMetrics();
+    
     return 0;
 }
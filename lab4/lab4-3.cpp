@@ -1,11 +1,36 @@
 // File: scheduling_algorithms.cpp
-// Compile: g++ -o scheduling_algorithms scheduling_algorithms.cpp -std=c++17
+// Compile: g++ -o scheduling_algorithms scheduling_algorithms.cpp -std=c++17 -pthread
 
 #include <iostream>
 #include <vector>
 #include <queue>
 #include <algorithm>
+#include <numeric>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <exception>
+#include <set>
 #include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <random>
+#include <cstdio>
+#include <filesystem>
+#include <sys/resource.h>
+#include <unistd.h>
 #include <iomanip>
 
 struct Process {
@@ -17,11 +42,13 @@ struct Process {
     int turnaround_time;
     int waiting_time;
     int priority;
+    long long vruntime; // CFS weighted virtual runtime
+    int response_time;  // Time from arrival to first dispatch, -1 until dispatched
     
     Process(int id, int at, int bt, int pr = 0) 
         : pid(id), arrival_time(at), burst_time(bt), 
           remaining_time(bt), priority(pr), 
-          completion_time(0), turnaround_time(0), waiting_time(0) {}
+          completion_time(0), turnaround_time(0), waiting_time(0), vruntime(0), response_time(-1) {}
 };
 
 // ProcessScheduler class to handle display and calculations
@@ -67,219 +94,1470 @@ public:
         }
         return total / processes.size();
     }
+    
+    double calculateAverageResponseTime() {
+        if (processes.empty()) return 0.0;
+        
+        double total = 0;
+        for (const auto& p : processes) {
+            total += p.response_time;
+        }
+        return total / processes.size();
+    }
 };
 
-class SchedulingAlgorithms {
+// Little-endian int32 encoding used by the binary trace and timeline formats
+inline void encodeInt32(std::vector<char>& out, int32_t field) {
+    uint32_t value = static_cast<uint32_t>(field);
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+inline int32_t decodeInt32(const char* bytes) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) {
+        value = (value << 8) | static_cast<unsigned char>(bytes[i]);
+    }
+    return static_cast<int32_t>(value);
+}
+
+// Streams arrival-sorted Process records from a trace file in fixed-size chunks.
+// CSV traces hold "pid,arrival,burst[,priority]" lines (lines starting with a
+// letter or '#' are skipped as headers/comments); binary traces start with
+// MAGIC followed by packed little-endian int32 records of the same four fields.
+// Each lab file builds on its own, so lab4-1.cpp keeps a copy of this reader;
+// a fix to one belongs in the other as well.
+class TraceReader {
 public:
-    // FCFS Scheduling
-    static void FCFS(std::vector<Process>& processes) {
-        std::sort(processes.begin(), processes.end(), 
-                  [](const Process& a, const Process& b) {
-                      return a.arrival_time < b.arrival_time;
-                  });
-        
-        int current_time = 0;
-        for (auto& p : processes) {
-            if (current_time < p.arrival_time) {
-                current_time = p.arrival_time;
-            }
-            p.completion_time = current_time + p.burst_time;
-            p.turnaround_time = p.completion_time - p.arrival_time;
-            p.waiting_time = p.turnaround_time - p.burst_time;
-            current_time = p.completion_time;
+    static constexpr char MAGIC[8] = {'P', 'R', 'O', 'C', 'T', 'R', 'C', '1'};
+    static constexpr size_t RECORD_SIZE = 4 * sizeof(int32_t);
+    static constexpr size_t CHUNK_SIZE = 1 << 20;
+
+private:
+    std::ifstream file;
+    std::vector<char> buffer;
+    size_t begin = 0;
+    size_t end = 0;
+    bool binary = false;
+    long long records = 0;
+    long long line_number = 0;   // CSV line, or binary record, last read
+    
+    // Move the unread tail to the front and append the next chunk
+    bool refill() {
+        if (!file) return false;
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+        file.read(buffer.data() + end, static_cast<std::streamsize>(buffer.size() - end));
+        end += static_cast<size_t>(file.gcount());
+        return file.gcount() > 0;
+    }
+    
+    // A negative arrival or a burst <= 0 would run the simulated clock backwards
+    // or break the per-process metrics
+    static void checkRange(const Process& p, const std::string& where) {
+        if (p.arrival_time < 0 || p.burst_time <= 0) {
+            throw std::runtime_error("Out-of-range trace record on " + where +
+                                     " (arrival must be >= 0 and burst > 0)");
         }
     }
     
-    // SJF Non-preemptive Scheduling
-    static void SJF(std::vector<Process>& processes) {
-        int n = processes.size();
-        std::vector<bool> completed(n, false);
-        int current_time = 0;
-        int completed_count = 0;
-        
-        while (completed_count < n) {
-            int shortest_job = -1;
-            int min_burst = INT_MAX;
-            
-            for (int i = 0; i < n; i++) {
-                if (!completed[i] && processes[i].arrival_time <= current_time) {
-                    if (processes[i].burst_time < min_burst) {
-                        min_burst = processes[i].burst_time;
-                        shortest_job = i;
-                    }
+    bool nextBinary(Process& p) {
+        if (end - begin < RECORD_SIZE && !refill() && begin == end) return false;
+        if (end - begin < RECORD_SIZE) {
+            throw std::runtime_error("Truncated binary trace record");
+        }
+        const char* rec = buffer.data() + begin;
+        p = Process(decodeInt32(rec), decodeInt32(rec + 4), decodeInt32(rec + 8), decodeInt32(rec + 12));
+        begin += RECORD_SIZE;
+        line_number++;
+        checkRange(p, "record " + std::to_string(line_number));
+        return true;
+    }
+    
+    bool nextCSV(Process& p) {
+        while (true) {
+            const char* first = buffer.data() + begin;
+            const char* newline = static_cast<const char*>(std::memchr(first, '\n', end - begin));
+            if (!newline) {
+                if (end - begin == buffer.size()) {
+                    throw std::runtime_error("Trace line exceeds chunk size");
                 }
+                if (refill()) continue;
+                if (begin == end) return false;
+                newline = buffer.data() + end; // last line without a trailing newline
             }
+            const char* last = newline;
+            begin = std::min(end, static_cast<size_t>(newline - buffer.data()) + 1);
+            line_number++;
             
-            if (shortest_job == -1) {
-                current_time++;
+            if (last > first && last[-1] == '\r') last--;
+            if (first == last || std::isalpha(static_cast<unsigned char>(*first)) || *first == '#') {
                 continue;
             }
             
-            processes[shortest_job].completion_time = current_time + processes[shortest_job].burst_time;
-            processes[shortest_job].turnaround_time = processes[shortest_job].completion_time - processes[shortest_job].arrival_time;
-            processes[shortest_job].waiting_time = processes[shortest_job].turnaround_time - processes[shortest_job].burst_time;
-            
-            current_time = processes[shortest_job].completion_time;
-            completed[shortest_job] = true;
-            completed_count++;
+            int fields[4] = {0, 0, 0, 0};
+            int count = 0;
+            for (const char* cur = first; count < 4; count++) {
+                while (cur < last && *cur == ' ') cur++;
+                auto [ptr, ec] = std::from_chars(cur, last, fields[count]);
+                if (ec != std::errc()) break;
+                cur = ptr;
+                while (cur < last && *cur == ' ') cur++;
+                if (cur == last || *cur != ',') { count++; break; }
+                cur++;
+            }
+            if (count < 3) {
+                throw std::runtime_error("Malformed trace record on line " + std::to_string(line_number));
+            }
+            p = Process(fields[0], fields[1], fields[2], fields[3]);
+            checkRange(p, "line " + std::to_string(line_number));
+            return true;
+        }
+    }
+
+public:
+    explicit TraceReader(const std::string& path, size_t chunk_size = CHUNK_SIZE)
+        : file(path, std::ios::binary), buffer(std::max(chunk_size, sizeof(MAGIC))) {
+        if (!file) {
+            throw std::runtime_error("Cannot open trace file: " + path);
         }
+        refill();
+        binary = end >= sizeof(MAGIC) && std::memcmp(buffer.data(), MAGIC, sizeof(MAGIC)) == 0;
+        if (binary) begin = sizeof(MAGIC);
     }
     
-    // SRTF (Preemptive SJF) Scheduling
-    static void SRTF(std::vector<Process>& processes) {
-        int n = processes.size();
-        std::vector<int> remaining_time(n);
+    bool next(Process& p) {
+        if (!(binary ? nextBinary(p) : nextCSV(p))) return false;
+        records++;
+        return true;
+    }
+    
+    bool isBinary() const { return binary; }
+    long long recordsRead() const { return records; }
+};
+
+// Writes the compact binary trace format read by TraceReader
+class TraceWriter {
+private:
+    std::ofstream file;
+    std::vector<char> buffer;
+
+public:
+    explicit TraceWriter(const std::string& path) : file(path, std::ios::binary) {
+        if (!file) {
+            throw std::runtime_error("Cannot create trace file: " + path);
+        }
+        buffer.reserve(TraceReader::CHUNK_SIZE);
+        file.write(TraceReader::MAGIC, sizeof(TraceReader::MAGIC));
+    }
+    
+    ~TraceWriter() { flush(); }
+    
+    void append(const Process& p) {
+        for (int32_t field : {p.pid, p.arrival_time, p.burst_time, p.priority}) {
+            encodeInt32(buffer, field);
+        }
+        if (buffer.size() >= TraceReader::CHUNK_SIZE) flush();
+    }
+    
+    void flush() {
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+};
+
+// One stretch of time during which a process held a CPU, as [start, end)
+struct TimelineSlice {
+    int32_t pid;
+    int32_t start;
+    int32_t end;
+    int32_t cpu;
+};
+
+// Append-only execution timeline. Slices are run-length encoded: a slice that
+// continues the previous one (same pid and CPU, no gap) extends it instead of
+// adding a record. The file is MAGIC followed by packed little-endian
+// (pid, start, end, cpu) int32 records.
+class TimelineRecorder {
+public:
+    static constexpr char MAGIC[8] = {'G', 'A', 'N', 'T', 'T', 'L', 'G', '1'};
+    static constexpr size_t RECORD_SIZE = 4 * sizeof(int32_t);
+
+private:
+    std::ofstream file;
+    std::vector<char> buffer;
+    TimelineSlice pending{0, 0, 0, 0};
+    bool has_pending = false;
+    long long slices = 0;
+    
+    void writePending() {
+        if (!has_pending) return;
+        for (int32_t field : {pending.pid, pending.start, pending.end, pending.cpu}) {
+            encodeInt32(buffer, field);
+        }
+        slices++;
+        has_pending = false;
+        if (buffer.size() >= TraceReader::CHUNK_SIZE) flush();
+    }
+    
+    void flush() {
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+
+public:
+    explicit TimelineRecorder(const std::string& path) : file(path, std::ios::binary) {
+        if (!file) {
+            throw std::runtime_error("Cannot create timeline file: " + path);
+        }
+        buffer.reserve(TraceReader::CHUNK_SIZE);
+        file.write(MAGIC, sizeof(MAGIC));
+    }
+    
+    ~TimelineRecorder() { close(); }
+    
+    void record(int pid, int start, int end, int cpu) {
+        if (end <= start) return;
+        if (has_pending && pending.pid == pid && pending.cpu == cpu && pending.end == start) {
+            pending.end = end;
+            return;
+        }
+        writePending();
+        pending = TimelineSlice{pid, start, end, cpu};
+        has_pending = true;
+    }
+    
+    void close() {
+        writePending();
+        flush();
+        file.flush();
+    }
+    
+    long long slicesWritten() const { return slices + (has_pending ? 1 : 0); }
+};
+
+// Answers "what ran on CPU c between t1 and t2" over a timeline file without
+// loading it. One pass summarises each fixed-size block of records as a
+// [min start, max end) interval per CPU; the summaries go into a per-CPU
+// interval tree, and a query reads back only the blocks whose interval overlaps.
+class TimelineIndex {
+private:
+    // Static interval tree: entries sorted by start, implicitly balanced around
+    // the midpoint, with the largest end in each subtree for pruning
+    struct IntervalTree {
+        struct Entry {
+            int32_t start;
+            int32_t end;
+            size_t block;
+        };
+        std::vector<Entry> entries;
+        std::vector<int32_t> max_end;
         
-        for (int i = 0; i < n; i++) {
-            remaining_time[i] = processes[i].burst_time;
+        int32_t build(size_t lo, size_t hi) {
+            if (lo >= hi) return INT32_MIN;
+            size_t mid = lo + (hi - lo) / 2;
+            max_end[mid] = std::max({entries[mid].end, build(lo, mid), build(mid + 1, hi)});
+            return max_end[mid];
         }
         
-        int current_time = 0;
-        int completed = 0;
+        void build() {
+            std::sort(entries.begin(), entries.end(),
+                      [](const Entry& a, const Entry& b) { return a.start < b.start; });
+            max_end.assign(entries.size(), INT32_MIN);
+            build(0, entries.size());
+        }
         
-        while (completed < n) {
-            int shortest = -1;
-            int min_remaining = INT_MAX;
+        void query(int32_t t1, int32_t t2, size_t lo, size_t hi, std::vector<size_t>& blocks) const {
+            if (lo >= hi) return;
+            size_t mid = lo + (hi - lo) / 2;
+            if (max_end[mid] <= t1) return;
+            query(t1, t2, lo, mid, blocks);
+            if (entries[mid].start >= t2) return;
+            if (entries[mid].end > t1) blocks.push_back(entries[mid].block);
+            query(t1, t2, mid + 1, hi, blocks);
+        }
+    };
+    
+    std::string path;
+    size_t block_records;
+    std::map<int32_t, IntervalTree> trees;
+    
+    std::vector<char> readBlock(std::ifstream& file, size_t block) const {
+        std::vector<char> data(block_records * TimelineRecorder::RECORD_SIZE);
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(sizeof(TimelineRecorder::MAGIC) + block * data.size()));
+        file.read(data.data(), static_cast<std::streamsize>(data.size()));
+        data.resize(static_cast<size_t>(file.gcount()) / TimelineRecorder::RECORD_SIZE * TimelineRecorder::RECORD_SIZE);
+        return data;
+    }
+    
+    static TimelineSlice decodeSlice(const char* rec) {
+        return TimelineSlice{decodeInt32(rec), decodeInt32(rec + 4), decodeInt32(rec + 8), decodeInt32(rec + 12)};
+    }
+    
+    std::ifstream open() const {
+        std::ifstream file(path, std::ios::binary);
+        char magic[sizeof(TimelineRecorder::MAGIC)];
+        if (!file.read(magic, sizeof(magic)) ||
+            std::memcmp(magic, TimelineRecorder::MAGIC, sizeof(magic)) != 0) {
+            throw std::runtime_error("Not a timeline file: " + path);
+        }
+        return file;
+    }
+
+public:
+    explicit TimelineIndex(const std::string& timeline_path, size_t records_per_block = 4096)
+        : path(timeline_path), block_records(std::max<size_t>(records_per_block, 1)) {
+        std::ifstream file = open();
+        for (size_t block = 0;; block++) {
+            std::vector<char> data = readBlock(file, block);
+            if (data.empty()) break;
             
-            for (int i = 0; i < n; i++) {
-                if (processes[i].arrival_time <= current_time && 
-                    remaining_time[i] < min_remaining && remaining_time[i] > 0) {
-                    min_remaining = remaining_time[i];
-                    shortest = i;
+            std::map<int32_t, std::pair<int32_t, int32_t>> spans; // cpu -> (min start, max end)
+            for (size_t off = 0; off < data.size(); off += TimelineRecorder::RECORD_SIZE) {
+                TimelineSlice slice = decodeSlice(data.data() + off);
+                auto [it, inserted] = spans.try_emplace(slice.cpu, slice.start, slice.end);
+                if (!inserted) {
+                    it->second.first = std::min(it->second.first, slice.start);
+                    it->second.second = std::max(it->second.second, slice.end);
+                }
+            }
+            for (const auto& [cpu, span] : spans) {
+                trees[cpu].entries.push_back({span.first, span.second, block});
+            }
+        }
+        for (auto& [cpu, tree] : trees) {
+            tree.build();
+        }
+    }
+    
+    // Slices on `cpu` overlapping [t1, t2), in timeline order
+    std::vector<TimelineSlice> query(int cpu, int t1, int t2) const {
+        std::vector<TimelineSlice> result;
+        auto it = trees.find(cpu);
+        if (it == trees.end() || t1 >= t2) return result;
+        
+        std::vector<size_t> blocks;
+        it->second.query(t1, t2, 0, it->second.entries.size(), blocks);
+        std::sort(blocks.begin(), blocks.end());
+        
+        std::ifstream file = open();
+        for (size_t block : blocks) {
+            std::vector<char> data = readBlock(file, block);
+            for (size_t off = 0; off < data.size(); off += TimelineRecorder::RECORD_SIZE) {
+                TimelineSlice slice = decodeSlice(data.data() + off);
+                if (slice.cpu == cpu && slice.start < t2 && slice.end > t1) {
+                    result.push_back(slice);
                 }
             }
+        }
+        return result;
+    }
+};
+
+// Clock shared by the simulators below. Every stretch of CPU time goes through
+// run(), which records first dispatch and feeds the optional timeline.
+class SimulationClock {
+protected:
+    int current_time = 0;
+    TimelineRecorder* timeline = nullptr;
+    int cpu = 0;
+    
+    void run(Process& p, int duration) {
+        if (p.response_time < 0) p.response_time = current_time - p.arrival_time;
+        if (timeline) timeline->record(p.pid, current_time, current_time + duration, cpu);
+        current_time += duration;
+    }
+
+public:
+    int now() const { return current_time; }
+    
+    void advanceTo(int time) { current_time = std::max(current_time, time); }
+    
+    void attachTimeline(TimelineRecorder* recorder, int cpu_id) {
+        timeline = recorder;
+        cpu = cpu_id;
+    }
+};
+
+// Discrete-event simulation core shared by the scheduling algorithms.
+// Arrivals are sorted once; the clock jumps straight to the next event
+// instead of stepping one tick at a time through idle gaps.
+class EventSimulator : public SimulationClock {
+private:
+    std::vector<Process>& processes;
+    std::vector<int> arrival_order;
+    size_t next_arrival;
+    size_t completed;
+
+public:
+    explicit EventSimulator(std::vector<Process>& procs)
+        : processes(procs), arrival_order(procs.size()), next_arrival(0), completed(0) {
+        std::iota(arrival_order.begin(), arrival_order.end(), 0);
+        std::stable_sort(arrival_order.begin(), arrival_order.end(),
+                         [this](int a, int b) {
+                             return processes[a].arrival_time < processes[b].arrival_time;
+                         });
+    }
+    
+    Process& process(int i) { return processes[i]; }
+    
+    // Tie-break order between equal keys: the position in the input vector
+    long long sequence(int i) const { return i; }
+    
+    bool finished() const { return completed == processes.size(); }
+    
+    bool hasPendingArrivals() const { return next_arrival < arrival_order.size(); }
+    
+    int nextArrivalTime() const { return processes[arrival_order[next_arrival]].arrival_time; }
+    
+    // Hand every process that has arrived by now() to the ready set, in arrival order
+    template <typename Admit>
+    void admitArrivals(Admit admit) {
+        while (hasPendingArrivals() && nextArrivalTime() <= current_time) {
+            int i = arrival_order[next_arrival++];
+            processes[i].response_time = -1;
+            admit(i);
+        }
+    }
+    
+    // Give process i the CPU from now() for `duration` units
+    void runFor(int i, int duration) { run(processes[i], duration); }
+    
+    void idleUntilNextArrival() { advanceTo(nextArrivalTime()); }
+    
+    void complete(int i) {
+        Process& p = processes[i];
+        p.completion_time = current_time;
+        p.turnaround_time = p.completion_time - p.arrival_time;
+        p.waiting_time = p.turnaround_time - p.burst_time;
+        completed++;
+    }
+};
+
+// Same interface as EventSimulator, but arrivals are pulled from a TraceReader
+// and each finished process is handed to on_complete and its slot recycled,
+// so memory is bounded by the number of arrived-but-unfinished processes.
+template <typename OnComplete>
+class TraceSimulator : public SimulationClock {
+private:
+    TraceReader& reader;
+    OnComplete on_complete;
+    std::vector<Process> slots;
+    std::vector<int> free_slots;
+    std::vector<long long> slot_sequence;
+    Process lookahead;
+    bool has_lookahead;
+    size_t live;
+    
+    void fetch() {
+        int last_arrival = lookahead.arrival_time;
+        has_lookahead = reader.next(lookahead);
+        if (has_lookahead && lookahead.arrival_time < last_arrival) {
+            throw std::runtime_error("Trace is not sorted by arrival time at record " +
+                                     std::to_string(reader.recordsRead()));
+        }
+    }
+
+public:
+    TraceSimulator(TraceReader& r, OnComplete cb)
+        : reader(r), on_complete(cb), lookahead(0, INT_MIN, 0), has_lookahead(false),
+          live(0) {
+        fetch();
+    }
+    
+    Process& process(int i) { return slots[i]; }
+    
+    // Tie-break order between equal keys: the record number in the trace
+    long long sequence(int i) const { return slot_sequence[i]; }
+    
+    bool finished() const { return !has_lookahead && live == 0; }
+    
+    bool hasPendingArrivals() const { return has_lookahead; }
+    
+    int nextArrivalTime() const { return lookahead.arrival_time; }
+    
+    template <typename Admit>
+    void admitArrivals(Admit admit) {
+        while (has_lookahead && lookahead.arrival_time <= current_time) {
+            int slot;
+            if (free_slots.empty()) {
+                slot = static_cast<int>(slots.size());
+                slots.push_back(lookahead);
+                slot_sequence.push_back(0);
+            } else {
+                slot = free_slots.back();
+                free_slots.pop_back();
+                slots[slot] = lookahead;
+            }
+            slot_sequence[slot] = reader.recordsRead() - 1;
+            live++;
+            fetch();
+            admit(slot);
+        }
+    }
+    
+    void runFor(int i, int duration) { run(slots[i], duration); }
+    
+    void idleUntilNextArrival() { advanceTo(nextArrivalTime()); }
+    
+    void complete(int i) {
+        Process& p = slots[i];
+        p.completion_time = current_time;
+        p.turnaround_time = p.completion_time - p.arrival_time;
+        p.waiting_time = p.turnaround_time - p.burst_time;
+        on_complete(p);
+        free_slots.push_back(i);
+        live--;
+    }
+    
+    // Largest number of processes resident at once
+    size_t peakResident() const { return slots.size(); }
+};
+
+// Binary min-heap over small integer ids that remembers where each id sits,
+// so a key can be lowered in place (decrease-key) in O(log n)
+template <typename Key>
+class IndexedMinHeap {
+private:
+    std::vector<int> heap;     // ids in heap order
+    std::vector<int> position; // id -> index in heap, -1 when absent
+    std::vector<Key> keys;     // id -> current key
+    
+    void place(size_t index, int id) {
+        heap[index] = id;
+        position[id] = static_cast<int>(index);
+    }
+    
+    void siftUp(size_t index) {
+        int id = heap[index];
+        while (index > 0) {
+            size_t parent = (index - 1) / 2;
+            if (!(keys[id] < keys[heap[parent]])) break;
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, id);
+    }
+    
+    void siftDown(size_t index) {
+        int id = heap[index];
+        while (true) {
+            size_t child = 2 * index + 1;
+            if (child >= heap.size()) break;
+            if (child + 1 < heap.size() && keys[heap[child + 1]] < keys[heap[child]]) child++;
+            if (!(keys[heap[child]] < keys[id])) break;
+            place(index, heap[child]);
+            index = child;
+        }
+        place(index, id);
+    }
+
+public:
+    bool empty() const { return heap.empty(); }
+    
+    bool contains(int id) const {
+        return id < static_cast<int>(position.size()) && position[id] >= 0;
+    }
+    
+    int top() const { return heap.front(); }
+    
+    const Key& key(int id) const { return keys[id]; }
+    
+    void push(int id, const Key& key) {
+        if (id >= static_cast<int>(position.size())) {
+            position.resize(id + 1, -1);
+            keys.resize(id + 1);
+        }
+        keys[id] = key;
+        heap.push_back(id);
+        siftUp(heap.size() - 1);
+    }
+    
+    int pop() {
+        int id = heap.front();
+        position[id] = -1;
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            place(0, last);
+            siftDown(0);
+        }
+        return id;
+    }
+    
+    // Lower id's key; key must not be greater than the current one
+    void decreaseKey(int id, const Key& key) {
+        keys[id] = key;
+        siftUp(static_cast<size_t>(position[id]));
+    }
+};
+
+// Fenwick (binary indexed) tree over ticket counts per id. Changing an id's
+// tickets and finding the holder of the r-th ticket are both O(log n); the
+// tree doubles its capacity when an id beyond it shows up.
+class TicketTree {
+private:
+    std::vector<long long> tree;    // 1-based Fenwick array
+    std::vector<long long> tickets; // id -> tickets currently held
+    long long total_tickets = 0;
+    
+    void grow(size_t capacity) {
+        tickets.resize(capacity, 0);
+        tree.assign(capacity + 1, 0);
+        for (size_t i = 1; i <= capacity; i++) {
+            tree[i] += tickets[i - 1];
+            size_t parent = i + (i & (~i + 1));
+            if (parent <= capacity) tree[parent] += tree[i];
+        }
+    }
+
+public:
+    long long total() const { return total_tickets; }
+    
+    void add(int id, long long delta) {
+        if (static_cast<size_t>(id) >= tickets.size()) {
+            size_t capacity = std::max<size_t>(tickets.size(), 16);
+            while (capacity <= static_cast<size_t>(id)) capacity *= 2;
+            grow(capacity);
+        }
+        tickets[id] += delta;
+        total_tickets += delta;
+        for (size_t i = id + 1; i < tree.size(); i += i & (~i + 1)) {
+            tree[i] += delta;
+        }
+    }
+    
+    // Id holding ticket number `ticket` (0 <= ticket < total())
+    int find(long long ticket) const {
+        size_t pos = 0;
+        size_t step = 1;
+        while (step * 2 < tree.size()) step *= 2;
+        for (; step > 0; step /= 2) {
+            if (pos + step < tree.size() && tree[pos + step] <= ticket) {
+                pos += step;
+                ticket -= tree[pos];
+            }
+        }
+        return static_cast<int>(pos);
+    }
+};
+
+class SchedulingAlgorithms {
+public:
+    enum class Policy { FCFS, SJF, SRTF, RoundRobin, Priority, MLFQ, CFS, PreemptivePriority, Lottery, Stride };
+    
+    static std::vector<Policy> allPolicies() {
+        return {Policy::FCFS, Policy::SJF, Policy::SRTF, Policy::RoundRobin,
+                Policy::Priority, Policy::MLFQ, Policy::CFS, Policy::PreemptivePriority,
+                Policy::Lottery, Policy::Stride};
+    }
+    
+    static const char* policyName(Policy policy) {
+        switch (policy) {
+            case Policy::FCFS: return "FCFS";
+            case Policy::SJF: return "SJF";
+            case Policy::SRTF: return "SRTF";
+            case Policy::RoundRobin: return "Round Robin";
+            case Policy::Priority: return "Priority";
+            case Policy::MLFQ: return "MLFQ";
+            case Policy::CFS: return "CFS";
+            case Policy::PreemptivePriority: return "Preemptive Priority";
+            case Policy::Lottery: return "Lottery";
+            case Policy::Stride: return "Stride";
+        }
+        return "Unknown";
+    }
+    
+    // Tuning knobs for the policies that take parameters
+    struct Options {
+        int quantum = 2;                          // Round Robin, Lottery and Stride time slice
+        std::vector<int> mlfq_quanta = {2, 4, 8}; // MLFQ time slice per level, highest first (1-64 levels, each > 0)
+        int mlfq_boost_interval = 50;             // MLFQ moves every process back to the top level this often (> 0)
+        int cfs_min_granularity = 1;              // CFS shortest slice a process is given
+        int cfs_target_latency = 8;               // CFS period in which every runnable process runs once
+        int aging_interval = 10;                  // Preemptive Priority: a waiting process gains one level this often (0 = off)
+        int aging_floor = 0;                      // Preemptive Priority: aging never raises a process above this priority
+        uint64_t lottery_seed = 1;                // Lottery random number seed
+        TimelineRecorder* timeline = nullptr;     // Records every execution slice when set
+        int cpu = 0;                              // CPU id written to the timeline
+    };
+    
+    // CFS load weight for a nice value (Linux sched_prio_to_weight); Process::priority is the nice value
+    static int cfsWeight(int nice) {
+        static const int weights[40] = {
+            88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916,
+            9548, 7620, 6100, 4904, 3906, 3121, 2501, 1991, 1586, 1277,
+            1024, 820, 655, 526, 423, 335, 272, 215, 172, 137,
+            110, 87, 70, 56, 45, 36, 29, 23, 18, 15
+        };
+        return weights[std::clamp(nice, -20, 19) + 20];
+    }
+    
+    // Lottery and Stride read Process::priority as a ticket count; every process holds at least one
+    static int tickets(const Process& p) { return std::max(p.priority, 1); }
+
+private:
+    // Min-heap of (key, sequence, index); ties go to the earlier process like a linear scan would
+    using ReadyEntry = std::tuple<int, long long, int>;
+    using ReadyHeap = std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, std::greater<ReadyEntry>>;
+    
+    // Run each selected process to completion, choosing the smallest key among arrived ones
+    template <typename Simulator, typename Key>
+    static void runNonPreemptive(Simulator& sim, Key key) {
+        ReadyHeap ready;
+        
+        while (!sim.finished()) {
+            sim.admitArrivals([&](int i) { ready.emplace(key(sim.process(i)), sim.sequence(i), i); });
+            
+            if (ready.empty()) {
+                sim.idleUntilNextArrival();
+                continue;
+            }
+            
+            int i = std::get<2>(ready.top());
+            ready.pop();
+            sim.runFor(i, sim.process(i).burst_time);
+            sim.complete(i);
+        }
+    }
+    
+    template <typename Simulator>
+    static void runSRTF(Simulator& sim) {
+        ReadyHeap ready; // (remaining_time, sequence, index)
+        
+        while (!sim.finished()) {
+            sim.admitArrivals([&](int i) { ready.emplace(sim.process(i).burst_time, sim.sequence(i), i); });
             
-            if (shortest == -1) {
-                current_time++;
+            if (ready.empty()) {
+                sim.idleUntilNextArrival();
                 continue;
             }
             
-            remaining_time[shortest]--;
-            current_time++;
+            auto [remaining, sequence, i] = ready.top();
+            ready.pop();
             
-            if (remaining_time[shortest] == 0) {
-                completed++;
-                processes[shortest].completion_time = current_time;
-                processes[shortest].turnaround_time = processes[shortest].completion_time - processes[shortest].arrival_time;
-                processes[shortest].waiting_time = processes[shortest].turnaround_time - processes[shortest].burst_time;
+            // The shortest job keeps the CPU until it finishes or the next arrival may preempt it
+            int run_until = sim.now() + remaining;
+            if (sim.hasPendingArrivals()) {
+                run_until = std::min(run_until, sim.nextArrivalTime());
+            }
+            remaining -= run_until - sim.now();
+            sim.runFor(i, run_until - sim.now());
+            
+            if (remaining == 0) {
+                sim.complete(i);
+            } else {
+                ready.emplace(remaining, sequence, i);
             }
         }
     }
     
-    // Round Robin Scheduling
-    static void RoundRobin(std::vector<Process>& processes, int quantum) {
+    template <typename Simulator>
+    static void runRoundRobin(Simulator& sim, int quantum) {
         std::queue<int> ready_queue;
-        std::vector<int> remaining_time(processes.size());
-        std::vector<bool> in_queue(processes.size(), false);
         
-        for (size_t i = 0; i < processes.size(); i++) {
-            remaining_time[i] = processes[i].burst_time;
+        auto enqueue = [&](int i) {
+            sim.process(i).remaining_time = sim.process(i).burst_time;
+            ready_queue.push(i);
+        };
+        
+        while (!sim.finished()) {
+            sim.admitArrivals(enqueue);
+            
+            if (ready_queue.empty()) {
+                sim.idleUntilNextArrival();
+                continue;
+            }
+            
+            int current_process = ready_queue.front();
+            ready_queue.pop();
+            
+            Process& p = sim.process(current_process);
+            int exec_time = std::min(quantum, p.remaining_time);
+            p.remaining_time -= exec_time;
+            sim.runFor(current_process, exec_time);
+            
+            // Processes that arrived during the slice queue ahead of the preempted one
+            sim.admitArrivals(enqueue);
+            
+            if (sim.process(current_process).remaining_time == 0) {
+                sim.complete(current_process);
+            } else {
+                ready_queue.push(current_process);
+            }
         }
+    }
+    
+    // Multi-level feedback queue: new processes enter the top level, a process that
+    // uses its full slice is demoted one level, and every boost interval all
+    // processes return to the top. A bitmap of non-empty levels makes picking the
+    // next level a single find-first-set, and a boost splices whole levels in O(levels).
+    template <typename Simulator>
+    static void runMLFQ(Simulator& sim, const std::vector<int>& quanta, int boost_interval) {
+        const int levels = static_cast<int>(quanta.size());
+        if (levels < 1 || levels > 64) {
+            throw std::invalid_argument("MLFQ needs between 1 and 64 levels");
+        }
+        for (int quantum : quanta) {
+            if (quantum <= 0) throw std::invalid_argument("MLFQ quanta must be positive");
+        }
+        if (boost_interval <= 0) {
+            throw std::invalid_argument("MLFQ boost interval must be positive");
+        }
+        std::vector<std::list<int>> queues(levels);
+        uint64_t non_empty = 0;
+        long long next_boost = boost_interval;
         
-        int current_time = 0;
-        int completed = 0;
+        auto enqueue = [&](int level, int i) {
+            queues[level].push_back(i);
+            non_empty |= uint64_t(1) << level;
+        };
         
-        // Sort by arrival time for initial processing
-        std::vector<int> arrival_order(processes.size());
-        for (size_t i = 0; i < processes.size(); i++) {
-            arrival_order[i] = i;
+        auto admit = [&](int i) {
+            sim.process(i).remaining_time = sim.process(i).burst_time;
+            enqueue(0, i);
+        };
+        
+        while (!sim.finished()) {
+            sim.admitArrivals(admit);
+            
+            if (sim.now() >= next_boost) {
+                for (int level = 1; level < levels; level++) {
+                    queues[0].splice(queues[0].end(), queues[level]);
+                }
+                non_empty = non_empty ? 1 : 0;
+                next_boost = (sim.now() / boost_interval + 1) * static_cast<long long>(boost_interval);
+            }
+            
+            if (!non_empty) {
+                sim.idleUntilNextArrival();
+                continue;
+            }
+            
+            int level = __builtin_ctzll(non_empty);
+            int current_process = queues[level].front();
+            queues[level].pop_front();
+            if (queues[level].empty()) {
+                non_empty &= ~(uint64_t(1) << level);
+            }
+            
+            Process& p = sim.process(current_process);
+            int exec_time = std::min(quanta[level], p.remaining_time);
+            p.remaining_time -= exec_time;
+            sim.runFor(current_process, exec_time);
+            
+            // Processes that arrived during the slice queue ahead of the demoted one
+            sim.admitArrivals(admit);
+            
+            if (p.remaining_time == 0) {
+                sim.complete(current_process);
+            } else {
+                // Used its whole slice: demote (the bottom level behaves like Round Robin)
+                enqueue(std::min(level + 1, levels - 1), current_process);
+            }
         }
-        std::sort(arrival_order.begin(), arrival_order.end(),
-                  [&processes](int a, int b) {
-                      return processes[a].arrival_time < processes[b].arrival_time;
-                  });
+    }
+    
+    // Completely fair scheduling: runnable processes sit in a red-black tree keyed by
+    // vruntime and the leftmost one runs next. Each runs for its weighted share of
+    // the scheduling period, and its vruntime advances inversely to its weight.
+    // vruntime is kept in 1/1024 time units so light weights do not round to zero.
+    template <typename Simulator>
+    static void runCFS(Simulator& sim, int min_granularity, int target_latency) {
+        constexpr long long NICE_0_WEIGHT = 1024;
+        std::set<std::tuple<long long, long long, int>> runnable; // (vruntime, sequence, index)
+        long long total_weight = 0;
+        long long min_vruntime = 0;
         
-        // Add first process if available
-        if (!processes.empty() && processes[arrival_order[0]].arrival_time <= current_time) {
-            ready_queue.push(arrival_order[0]);
-            in_queue[arrival_order[0]] = true;
+        // New processes start at the queue's minimum vruntime so they cannot monopolise the CPU
+        auto admit = [&](int i) {
+            Process& p = sim.process(i);
+            p.remaining_time = p.burst_time;
+            p.vruntime = min_vruntime;
+            runnable.emplace(p.vruntime, sim.sequence(i), i);
+            total_weight += cfsWeight(p.priority);
+        };
+        
+        while (!sim.finished()) {
+            sim.admitArrivals(admit);
+            
+            if (runnable.empty()) {
+                sim.idleUntilNextArrival();
+                continue;
+            }
+            
+            auto [vruntime, sequence, current_process] = *runnable.begin();
+            runnable.erase(runnable.begin());
+            
+            Process& p = sim.process(current_process);
+            long long weight = cfsWeight(p.priority);
+            long long nr_running = static_cast<long long>(runnable.size()) + 1;
+            long long period = std::max<long long>(target_latency, nr_running * min_granularity);
+            int slice = static_cast<int>(std::max<long long>(min_granularity, period * weight / total_weight));
+            
+            int exec_time = std::min(std::max(slice, 1), p.remaining_time);
+            p.remaining_time -= exec_time;
+            p.vruntime += exec_time * NICE_0_WEIGHT * 1024 / weight;
+            sim.runFor(current_process, exec_time);
+            
+            long long leftmost = runnable.empty() ? p.vruntime : std::get<0>(*runnable.begin());
+            min_vruntime = std::max(min_vruntime, std::min(p.vruntime, leftmost));
+            
+            sim.admitArrivals(admit);
+            
+            if (p.remaining_time == 0) {
+                total_weight -= weight;
+                sim.complete(current_process);
+            } else {
+                runnable.emplace(p.vruntime, sequence, current_process);
+            }
         }
+    }
+    
+public:
+    // Preemptive priority with aging. Ready processes live in an indexed heap keyed by
+    // (effective priority, sequence). Every aging_interval a process spends waiting,
+    // its effective priority improves by one level (down to aging_floor) through a
+    // decrease-key; the aging deadlines are themselves events in a min-heap, so no
+    // scan of the waiting processes is needed. A running process keeps its aged
+    // priority and is preempted only by a strictly higher one; a preempted process
+    // re-enters the heap at its base priority and ages again from there.
+    template <typename Simulator>
+    static void runPreemptivePriority(Simulator& sim, int aging_interval, int aging_floor) {
+        using Key = std::pair<int, long long>;
+        IndexedMinHeap<Key> ready;
+        std::vector<int> effective;   // id -> current effective priority
+        std::vector<int> ready_since; // id -> time it last entered the ready heap
+        std::priority_queue<std::tuple<int, int, int>, std::vector<std::tuple<int, int, int>>,
+                            std::greater<std::tuple<int, int, int>>> aging; // (due time, id, ready_since)
+        int running = -1;
         
-        while (!ready_queue.empty() || completed < (int)processes.size()) {
-            if (ready_queue.empty()) {
-                // Find next arriving process
-                for (int idx : arrival_order) {
-                    if (remaining_time[idx] > 0 && processes[idx].arrival_time > current_time) {
-                        current_time = processes[idx].arrival_time;
-                        ready_queue.push(idx);
-                        in_queue[idx] = true;
-                        break;
-                    }
+        auto enterReady = [&](int i) {
+            ready_since[i] = sim.now();
+            ready.push(i, Key(effective[i], sim.sequence(i)));
+            if (aging_interval > 0 && effective[i] > aging_floor) {
+                aging.emplace(sim.now() + aging_interval, i, sim.now());
+            }
+        };
+        
+        auto admit = [&](int i) {
+            Process& p = sim.process(i);
+            p.remaining_time = p.burst_time;
+            if (i >= static_cast<int>(effective.size())) {
+                effective.resize(i + 1);
+                ready_since.resize(i + 1);
+            }
+            effective[i] = p.priority;
+            enterReady(i);
+        };
+        
+        
+        while (!sim.finished()) {
+            sim.admitArrivals(admit);
+            
+            // Age every waiting process whose deadline has passed; stale deadlines
+            // (the process ran since) are dropped
+            while (!aging.empty() && std::get<0>(aging.top()) <= sim.now()) {
+                auto [due, i, since] = aging.top();
+                aging.pop();
+                if (!ready.contains(i) || ready_since[i] != since || effective[i] <= aging_floor) continue;
+                effective[i]--;
+                ready.decreaseKey(i, Key(effective[i], sim.sequence(i)));
+                if (effective[i] > aging_floor) {
+                    aging.emplace(due + aging_interval, i, since);
                 }
-                if (ready_queue.empty()) break; // No more processes
             }
             
-            int current_process = ready_queue.front();
-            ready_queue.pop();
-            in_queue[current_process] = false;
-            
-            int exec_time = std::min(quantum, remaining_time[current_process]);
-            remaining_time[current_process] -= exec_time;
-            current_time += exec_time;
-            
-            // Add newly arrived processes
-            for (int idx : arrival_order) {
-                if (!in_queue[idx] && remaining_time[idx] > 0 && 
-                    processes[idx].arrival_time <= current_time && idx != current_process) {
-                    ready_queue.push(idx);
-                    in_queue[idx] = true;
+            if (running == -1) {
+                if (ready.empty()) {
+                    sim.idleUntilNextArrival();
+                    continue;
                 }
+                running = ready.pop();
+            } else if (!ready.empty() && ready.key(ready.top()).first < effective[running]) {
+                int preempted = running;
+                running = ready.pop();
+                effective[preempted] = sim.process(preempted).priority;
+                enterReady(preempted);
             }
             
-            if (remaining_time[current_process] == 0) {
-                completed++;
-                processes[current_process].completion_time = current_time;
-                processes[current_process].turnaround_time = 
-                    processes[current_process].completion_time - processes[current_process].arrival_time;
-                processes[current_process].waiting_time = 
-                    processes[current_process].turnaround_time - processes[current_process].burst_time;
+            // Run until the process finishes or the next arrival/aging event may preempt it
+            Process& p = sim.process(running);
+            int run_until = sim.now() + p.remaining_time;
+            if (sim.hasPendingArrivals()) {
+                run_until = std::min(run_until, sim.nextArrivalTime());
+            }
+            if (!aging.empty()) {
+                run_until = std::min(run_until, std::get<0>(aging.top()));
+            }
+            p.remaining_time -= run_until - sim.now();
+            sim.runFor(running, run_until - sim.now());
+            
+            if (p.remaining_time == 0) {
+                sim.complete(running);
+                running = -1;
+            }
+        }
+    }
+    
+    // Lottery scheduling: each quantum goes to the holder of a uniformly drawn
+    // ticket. Ticket counts live in a Fenwick tree, so a draw is O(log n).
+    template <typename Simulator>
+    static void runLottery(Simulator& sim, int quantum, uint64_t seed) {
+        TicketTree runnable;
+        std::mt19937_64 rng(seed);
+        
+        auto admit = [&](int i) {
+            Process& p = sim.process(i);
+            p.remaining_time = p.burst_time;
+            runnable.add(i, tickets(p));
+        };
+        
+        while (!sim.finished()) {
+            sim.admitArrivals(admit);
+            
+            if (runnable.total() == 0) {
+                sim.idleUntilNextArrival();
+                continue;
+            }
+            
+            int winner = runnable.find(static_cast<long long>(rng() % static_cast<uint64_t>(runnable.total())));
+            Process& p = sim.process(winner);
+            int exec_time = std::min(quantum, p.remaining_time);
+            p.remaining_time -= exec_time;
+            sim.runFor(winner, exec_time);
+            
+            if (p.remaining_time == 0) {
+                runnable.add(winner, -tickets(p));
+                sim.complete(winner);
+            }
+        }
+    }
+    
+    // Stride scheduling: each process advances its pass by STRIDE1 / tickets per
+    // quantum and the lowest pass runs next, from a min-heap. New processes start
+    // at the lowest pass in the heap so they cannot claim a backlog of CPU time.
+    template <typename Simulator>
+    static void runStride(Simulator& sim, int quantum) {
+        constexpr long long STRIDE1 = 1 << 20;
+        std::priority_queue<std::tuple<long long, long long, int>, std::vector<std::tuple<long long, long long, int>>,
+                            std::greater<std::tuple<long long, long long, int>>> runnable; // (pass, sequence, index)
+        long long global_pass = 0;
+        
+        auto admit = [&](int i) {
+            Process& p = sim.process(i);
+            p.remaining_time = p.burst_time;
+            runnable.emplace(global_pass, sim.sequence(i), i);
+        };
+        
+        while (!sim.finished()) {
+            sim.admitArrivals(admit);
+            
+            if (runnable.empty()) {
+                sim.idleUntilNextArrival();
+                continue;
+            }
+            
+            auto [pass, sequence, current_process] = runnable.top();
+            runnable.pop();
+            global_pass = std::max(global_pass, pass);
+            
+            Process& p = sim.process(current_process);
+            int exec_time = std::min(quantum, p.remaining_time);
+            p.remaining_time -= exec_time;
+            sim.runFor(current_process, exec_time);
+            
+            if (!runnable.empty()) {
+                global_pass = std::max(global_pass, std::get<0>(runnable.top()));
+            }
+            sim.admitArrivals(admit);
+            
+            if (p.remaining_time == 0) {
+                sim.complete(current_process);
             } else {
-                ready_queue.push(current_process);
-                in_queue[current_process] = true;
+                runnable.emplace(pass + std::max(STRIDE1 / tickets(p), 1LL), sequence, current_process); // >= 1 even past 2^20 tickets
             }
         }
     }
     
+    template <typename Simulator>
+    static void run(Simulator& sim, Policy policy, const Options& options) {
+        sim.attachTimeline(options.timeline, options.cpu);
+        switch (policy) {
+            case Policy::FCFS:
+                runNonPreemptive(sim, [](const Process& p) { return p.arrival_time; });
+                break;
+            case Policy::SJF:
+                runNonPreemptive(sim, [](const Process& p) { return p.burst_time; });
+                break;
+            case Policy::SRTF:
+                runSRTF(sim);
+                break;
+            case Policy::RoundRobin:
+                runRoundRobin(sim, options.quantum);
+                break;
+            case Policy::Priority:
+                // Lower number = higher priority
+                runNonPreemptive(sim, [](const Process& p) { return p.priority; });
+                break;
+            case Policy::MLFQ:
+                runMLFQ(sim, options.mlfq_quanta, options.mlfq_boost_interval);
+                break;
+            case Policy::CFS:
+                runCFS(sim, options.cfs_min_granularity, options.cfs_target_latency);
+                break;
+            case Policy::PreemptivePriority:
+                runPreemptivePriority(sim, options.aging_interval, options.aging_floor);
+                break;
+            case Policy::Lottery:
+                runLottery(sim, options.quantum, options.lottery_seed);
+                break;
+            case Policy::Stride:
+                runStride(sim, options.quantum);
+                break;
+        }
+    }
+    
+    // FCFS Scheduling
+    static void FCFS(std::vector<Process>& processes) {
+        std::stable_sort(processes.begin(), processes.end(), 
+                         [](const Process& a, const Process& b) {
+                             return a.arrival_time < b.arrival_time;
+                         });
+        
+        EventSimulator sim(processes);
+        run(sim, Policy::FCFS, Options());
+    }
+    
+    // SJF Non-preemptive Scheduling
+    static void SJF(std::vector<Process>& processes) {
+        EventSimulator sim(processes);
+        run(sim, Policy::SJF, Options());
+    }
+    
+    // SRTF (Preemptive SJF) Scheduling
+    static void SRTF(std::vector<Process>& processes) {
+        EventSimulator sim(processes);
+        run(sim, Policy::SRTF, Options());
+    }
+    
+    // Round Robin Scheduling
+    static void RoundRobin(std::vector<Process>& processes, int quantum) {
+        EventSimulator sim(processes);
+        Options options;
+        options.quantum = quantum;
+        run(sim, Policy::RoundRobin, options);
+    }
+    
     // Priority Scheduling (Non-preemptive)
     static void PriorityScheduling(std::vector<Process>& processes) {
-        int n = processes.size();
-        std::vector<bool> completed(n, false);
-        int current_time = 0;
-        int completed_count = 0;
-        
-        while (completed_count < n) {
-            int highest_priority_job = -1;
-            int highest_priority = INT_MAX; // Lower number = higher priority
-            
-            for (int i = 0; i < n; i++) {
-                if (!completed[i] && processes[i].arrival_time <= current_time) {
-                    if (processes[i].priority < highest_priority) {
-                        highest_priority = processes[i].priority;
-                        highest_priority_job = i;
+        EventSimulator sim(processes);
+        run(sim, Policy::Priority, Options());
+    }
+    
+    // Multi-Level Feedback Queue Scheduling
+    static void MLFQ(std::vector<Process>& processes, const std::vector<int>& quanta, int boost_interval) {
+        EventSimulator sim(processes);
+        Options options;
+        options.mlfq_quanta = quanta;
+        options.mlfq_boost_interval = boost_interval;
+        run(sim, Policy::MLFQ, options);
+    }
+    
+    // Completely Fair Scheduling (weight from priority as a nice value)
+    static void CFS(std::vector<Process>& processes, int min_granularity, int target_latency) {
+        EventSimulator sim(processes);
+        Options options;
+        options.cfs_min_granularity = min_granularity;
+        options.cfs_target_latency = target_latency;
+        run(sim, Policy::CFS, options);
+    }
+    
+    // Priority Scheduling (Preemptive, with aging; aging_interval 0 disables aging)
+    static void PreemptivePriorityScheduling(std::vector<Process>& processes, int aging_interval) {
+        EventSimulator sim(processes);
+        Options options;
+        options.aging_interval = aging_interval;
+        run(sim, Policy::PreemptivePriority, options);
+    }
+    
+    // Lottery Scheduling (tickets = priority)
+    static void LotteryScheduling(std::vector<Process>& processes, int quantum, uint64_t seed = 1) {
+        EventSimulator sim(processes);
+        Options options;
+        options.quantum = quantum;
+        options.lottery_seed = seed;
+        run(sim, Policy::Lottery, options);
+    }
+    
+    // Stride Scheduling (tickets = priority)
+    static void StrideScheduling(std::vector<Process>& processes, int quantum) {
+        EventSimulator sim(processes);
+        Options options;
+        options.quantum = quantum;
+        run(sim, Policy::Stride, options);
+    }
+    
+    // Replay an arrival-sorted trace, handing each finished process to on_complete.
+    // Returns the largest number of processes that were resident at once.
+    template <typename OnComplete>
+    static size_t replay(TraceReader& reader, Policy policy, const Options& options, OnComplete on_complete) {
+        TraceSimulator<OnComplete> sim(reader, on_complete);
+        run(sim, policy, options);
+        return sim.peakResident();
+    }
+};
+
+// Throughput and memory figures for one trace replay
+struct ReplayStats {
+    long long records = 0;
+    double seconds = 0.0;
+    size_t peak_resident = 0;
+    long peak_rss_kb = 0;
+    double total_waiting = 0.0;
+    double total_turnaround = 0.0;
+    double total_response = 0.0;
+    
+    static long currentPeakRSS() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss; // kilobytes on Linux
+    }
+    
+    static ReplayStats run(const std::string& path, SchedulingAlgorithms::Policy policy,
+                           const SchedulingAlgorithms::Options& options) {
+        ReplayStats stats;
+        auto start = std::chrono::steady_clock::now();
+        
+        TraceReader reader(path);
+        stats.peak_resident = SchedulingAlgorithms::replay(reader, policy, options,
+            [&stats](const Process& p) {
+                stats.total_waiting += p.waiting_time;
+                stats.total_turnaround += p.turnaround_time;
+                stats.total_response += p.response_time;
+            });
+        
+        stats.records = reader.recordsRead();
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stats.peak_rss_kb = currentPeakRSS();
+        return stats;
+    }
+    
+    void display() const {
+        double avg_waiting = records ? total_waiting / records : 0.0;
+        double avg_turnaround = records ? total_turnaround / records : 0.0;
+        double avg_response = records ? total_response / records : 0.0;
+        std::cout << "Records: " << records
+                  << ", Records/sec: " << static_cast<long long>(seconds > 0 ? records / seconds : 0)
+                  << ", Peak resident processes: " << peak_resident
+                  << ", Peak RSS: " << peak_rss_kb << " KB\n";
+        std::cout << "Average Waiting Time: " << avg_waiting << "\n";
+        std::cout << "Average Turnaround Time: " << avg_turnaround << "\n";
+        std::cout << "Average Response Time: " << avg_response << "\n\n";
+    }
+};
+
+// Runs every cell of a policy x quantum x trace x core-count grid in parallel.
+// Each trace is loaded once into a shared read-only snapshot; a cell copies only
+// the processes it schedules. With N cores the simulated machine has N partitioned
+// run queues: processes are dealt to cores in arrival order and each core runs the
+// policy on its own queue. The quantum axis applies to Round Robin, Lottery, Stride
+// and MLFQ (whose levels get quantum, 2*quantum, 4*quantum); other policies get one
+// cell per trace.
+class ParameterSweep {
+public:
+    struct Cell {
+        SchedulingAlgorithms::Policy policy;
+        int quantum; // 0 when the policy takes no quantum
+        size_t trace;
+        int cores;
+        double avg_waiting = 0.0;
+        double avg_turnaround = 0.0;
+        double avg_response = 0.0;
+    };
+
+private:
+    using Snapshot = std::shared_ptr<const std::vector<Process>>;
+    
+    std::vector<SchedulingAlgorithms::Policy> policies;
+    std::vector<int> quanta;
+    std::vector<std::string> trace_paths;
+    std::vector<Snapshot> traces;
+    std::vector<int> core_counts;
+    std::vector<Cell> cells;
+    
+    static bool usesQuantum(SchedulingAlgorithms::Policy policy) {
+        return policy == SchedulingAlgorithms::Policy::RoundRobin ||
+               policy == SchedulingAlgorithms::Policy::MLFQ ||
+               policy == SchedulingAlgorithms::Policy::Lottery ||
+               policy == SchedulingAlgorithms::Policy::Stride;
+    }
+    
+    void runCell(Cell& cell) const {
+        const std::vector<Process>& snapshot = *traces[cell.trace];
+        if (snapshot.empty()) return;
+        
+        SchedulingAlgorithms::Options options;
+        if (cell.quantum > 0) {
+            options.quantum = cell.quantum;
+            options.mlfq_quanta = {cell.quantum, 2 * cell.quantum, 4 * cell.quantum};
+        }
+        
+        double waiting = 0, turnaround = 0, response = 0;
+        for (int core = 0; core < cell.cores; core++) {
+            std::vector<Process> run_queue;
+            run_queue.reserve(snapshot.size() / cell.cores + 1);
+            for (size_t i = core; i < snapshot.size(); i += cell.cores) {
+                run_queue.push_back(snapshot[i]);
+            }
+            
+            EventSimulator sim(run_queue);
+            SchedulingAlgorithms::run(sim, cell.policy, options);
+            for (const auto& p : run_queue) {
+                waiting += p.waiting_time;
+                turnaround += p.turnaround_time;
+                response += p.response_time;
+            }
+        }
+        cell.avg_waiting = waiting / snapshot.size();
+        cell.avg_turnaround = turnaround / snapshot.size();
+        cell.avg_response = response / snapshot.size();
+    }
+
+public:
+    void addPolicy(SchedulingAlgorithms::Policy policy) { policies.push_back(policy); }
+    
+    void addQuantum(int quantum) { quanta.push_back(quantum); }
+    
+    void addCoreCount(int cores) { core_counts.push_back(std::max(cores, 1)); }
+    
+    void addTrace(const std::string& path) {
+        auto processes = std::make_shared<std::vector<Process>>();
+        TraceReader reader(path);
+        Process p(0, 0, 0);
+        while (reader.next(p)) {
+            processes->push_back(p);
+        }
+        std::stable_sort(processes->begin(), processes->end(),
+                         [](const Process& a, const Process& b) {
+                             return a.arrival_time < b.arrival_time;
+                         });
+        trace_paths.push_back(path);
+        traces.push_back(std::move(processes));
+    }
+    
+    // Run every cell on up to `threads` worker threads (default: one per hardware thread)
+    void run(unsigned threads = std::thread::hardware_concurrency()) {
+        cells.clear();
+        for (auto policy : policies) {
+            std::vector<int> cell_quanta = usesQuantum(policy) ? quanta : std::vector<int>{0};
+            for (int quantum : cell_quanta) {
+                for (size_t trace = 0; trace < traces.size(); trace++) {
+                    for (int cores : core_counts) {
+                        cells.push_back(Cell{policy, quantum, trace, cores});
                     }
                 }
             }
-            
-            if (highest_priority_job == -1) {
-                current_time++;
-                continue;
+        }
+        
+        std::atomic<size_t> next_cell{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto worker = [&]() {
+            for (size_t i = next_cell++; i < cells.size(); i = next_cell++) {
+                try {
+                    runCell(cells[i]);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                }
             }
-            
-            processes[highest_priority_job].completion_time = current_time + processes[highest_priority_job].burst_time;
-            processes[highest_priority_job].turnaround_time = 
-                processes[highest_priority_job].completion_time - processes[highest_priority_job].arrival_time;
-            processes[highest_priority_job].waiting_time = 
-                processes[highest_priority_job].turnaround_time - processes[highest_priority_job].burst_time;
-            
-            current_time = processes[highest_priority_job].completion_time;
-            completed[highest_priority_job] = true;
-            completed_count++;
+        };
+        
+        threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(cells.size())));
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back(worker);
         }
+        for (auto& w : workers) {
+            w.join();
+        }
+        if (error) std::rethrow_exception(error);
     }
+    
+    void writeCSV(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error("Cannot create sweep output: " + path);
+        }
+        out << "policy,quantum,trace,cores,avg_waiting,avg_turnaround,avg_response\n";
+        for (const auto& cell : cells) {
+            out << SchedulingAlgorithms::policyName(cell.policy) << ','
+                << (cell.quantum > 0 ? std::to_string(cell.quantum) : "") << ','
+                << trace_paths[cell.trace] << ',' << cell.cores << ','
+                << cell.avg_waiting << ',' << cell.avg_turnaround << ',' << cell.avg_response << '\n';
+        }
+    }
+    
+    size_t cellCount() const { return cells.size(); }
 };
 
 // Demo main function
-int main() {
+// Usage: scheduling_algorithms [trace.csv|trace.bin [quantum]] replays a trace with every policy
+//        scheduling_algorithms --sweep results.csv trace... runs the parameter sweep grid
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--sweep") {
+        if (argc < 4) {
+            std::cerr << "Usage: " << argv[0] << " --sweep results.csv trace...\n";
+            return 1;
+        }
+        try {
+            ParameterSweep sweep;
+            for (auto policy : SchedulingAlgorithms::allPolicies()) sweep.addPolicy(policy);
+            for (int quantum : {1, 2, 4, 8, 16}) sweep.addQuantum(quantum);
+            for (int cores : {1, 2, 4, 8}) sweep.addCoreCount(cores);
+            for (int i = 3; i < argc; i++) sweep.addTrace(argv[i]);
+            
+            auto start = std::chrono::steady_clock::now();
+            sweep.run();
+            sweep.writeCSV(argv[2]);
+            std::cout << "Swept " << sweep.cellCount() << " cells in "
+                      << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                      << "s, results written to " << argv[2] << "\n";
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    
+    if (argc > 1) {
+        SchedulingAlgorithms::Options options;
+        if (argc > 2) {
+            char* end = nullptr;
+            long quantum = std::strtol(argv[2], &end, 10);
+            if (end == argv[2] || *end != '\0' || quantum <= 0 || quantum > INT_MAX) {
+                std::cerr << "Usage: " << argv[0] << " [trace.csv|trace.bin [quantum]]\n"
+                          << "quantum must be a positive integer, got '" << argv[2] << "'\n";
+                return 1;
+            }
+            options.quantum = static_cast<int>(quantum);
+        }
+        try {
+            for (auto policy : SchedulingAlgorithms::allPolicies()) {
+                std::cout << "=== " << SchedulingAlgorithms::policyName(policy) << " Trace Replay ===\n";
+                ReplayStats::run(argv[1], policy, options).display();
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    
     // Test data pid, arrival_time, burst_time, priority
     std::vector<Process> processes = {
         Process(1, 0, 7, 2),
@@ -329,5 +1607,68 @@ int main() {
     std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
     std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n\n";
     
+    std::cout << "=== MLFQ (Quanta=1,2,4, Boost=10) Scheduling ===\n";
+    auto mlfq_processes = processes;
+    SchedulingAlgorithms::MLFQ(mlfq_processes, {1, 2, 4}, 10);
+    scheduler.processes = mlfq_processes;
+    scheduler.displayProcesses();
+    std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
+    std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n\n";
+    
+    std::cout << "=== CFS (Min Granularity=1, Target Latency=8) Scheduling ===\n";
+    auto cfs_processes = processes;
+    SchedulingAlgorithms::CFS(cfs_processes, 1, 8);
+    scheduler.processes = cfs_processes;
+    scheduler.displayProcesses();
+    std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
+    std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n\n";
+    
+    std::cout << "=== Preemptive Priority (Aging=5) Scheduling ===\n";
+    auto aging_processes = processes;
+    SchedulingAlgorithms::PreemptivePriorityScheduling(aging_processes, 5);
+    scheduler.processes = aging_processes;
+    scheduler.displayProcesses();
+    std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
+    std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n\n";
+    
+    std::cout << "=== Lottery (Quantum=2, Tickets=Priority) Scheduling ===\n";
+    auto lottery_processes = processes;
+    SchedulingAlgorithms::LotteryScheduling(lottery_processes, 2);
+    scheduler.processes = lottery_processes;
+    scheduler.displayProcesses();
+    std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
+    std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n\n";
+    
+    std::cout << "=== Stride (Quantum=2, Tickets=Priority) Scheduling ===\n";
+    auto stride_processes = processes;
+    SchedulingAlgorithms::StrideScheduling(stride_processes, 2);
+    scheduler.processes = stride_processes;
+    scheduler.displayProcesses();
+    std::cout << "Average Waiting Time: " << scheduler.calculateAverageWaitingTime() << "\n";
+    std::cout << "Average Turnaround Time: " << scheduler.calculateAverageTurnaroundTime() << "\n\n";
+    
+    std::cout << "=== Round Robin (Quantum=2) Gantt Chart ===\n";
+    {
+        auto gantt_processes = processes;
+        SchedulingAlgorithms::Options options;
+        options.quantum = 2;
+        // Scratch file in the temp directory, removed once the slices are read back
+        std::string timeline_path = (std::filesystem::temp_directory_path() /
+                                     ("gantt_timeline_" + std::to_string(getpid()) + ".bin")).string();
+        {
+            TimelineRecorder recorder(timeline_path);
+            options.timeline = &recorder;
+            EventSimulator sim(gantt_processes);
+            SchedulingAlgorithms::run(sim, SchedulingAlgorithms::Policy::RoundRobin, options);
+        }
+        
+        std::vector<TimelineSlice> slices = TimelineIndex(timeline_path).query(0, 0, INT_MAX);
+        std::remove(timeline_path.c_str());
+        for (const auto& slice : slices) {
+            std::cout << "| P" << slice.pid << " " << slice.start << "-" << slice.end << " ";
+        }
+        std::cout << "|\n\n";
+    }
+    
     return 0;
 }
@@ -1,5 +1,6 @@
 // File: thread_scheduling.cpp
-// Compile: g++ -o thread_scheduling thread_scheduling.cpp -std=c++17 -pthread
+// Compile: g++ -o thread_scheduling thread_scheduling.cpp -std=c++20 -pthread
+//          (-std=c++17 also builds, without the coroutine execution mode)
 
 #include <iostream>
 #include <thread>
@@ -11,21 +12,122 @@
 #include <atomic>
 #include <algorithm>
 #include <functional>
+#include <deque>
+#include <random>
+#include <cstdint>
+#include <exception>
+#include <utility>
+#include <list>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <climits>
+#include <pthread.h>
+#include <sched.h>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define HAVE_COROUTINES 1
+#endif
+
+// Pthread-style thread attributes simulation with custom enum names
+class ThreadAttributes {
+public:
+    // Use custom names to avoid conflicts with system constants
+    // POLICY_DEADLINE mirrors SCHED_DEADLINE: earliest deadline first, ahead of FIFO/RR
+    enum SchedulingPolicy { POLICY_FIFO, POLICY_RR, POLICY_OTHER, POLICY_DEADLINE, POLICY_COUNT };
+    enum ContentionScope { SCOPE_PROCESS, SCOPE_SYSTEM };
+    
+    SchedulingPolicy policy = POLICY_OTHER;
+    ContentionScope scope = SCOPE_SYSTEM;
+    int priority = 0;
+    // POLICY_DEADLINE only: worst-case run time, relative deadline and
+    // minimum inter-arrival time of the thread, in ms
+    int runtime_ms = 0;
+    int deadline_ms = 0;
+    int period_ms = 0;
+    
+    void setSchedulingPolicy(SchedulingPolicy pol) { policy = pol; }
+    void setContentionScope(ContentionScope sc) { scope = sc; }
+    void setPriority(int prio) { priority = prio; }
+    // deadline 0 = implicit (the period)
+    void setDeadlineParams(int runtime, int deadline, int period) {
+        runtime_ms = runtime;
+        deadline_ms = deadline > 0 ? deadline : period;
+        period_ms = period;
+    }
+    
+    static const char* policyName(SchedulingPolicy pol) {
+        return pol == POLICY_FIFO ? "FIFO" : pol == POLICY_RR ? "Round Robin"
+             : pol == POLICY_DEADLINE ? "Deadline" : "Other";
+    }
+    
+    void displayAttributes() const {
+        std::cout << "Thread Attributes:\n";
+        std::cout << "  Policy: " << policyName(policy) << "\n";
+        std::cout << "  Scope: " << (scope == SCOPE_PROCESS ? "Process" : "System") << "\n";
+        std::cout << "  Priority: " << priority << "\n";
+        if (policy == POLICY_DEADLINE) {
+            std::cout << "  Runtime/Deadline/Period: " << runtime_ms << "/" << deadline_ms
+                      << "/" << period_ms << "ms\n";
+        }
+    }
+};
 
 class ThreadInfo {
 public:
     int thread_id;
     int priority;
     int burst_time;
+    // Threads created without attributes keep the original behaviour: strict
+    // priority, each running to completion - SCHED_FIFO that is never preempted
+    ThreadAttributes::SchedulingPolicy policy = ThreadAttributes::POLICY_FIFO;
+    bool preemptible = false;  // Set for threads created with attributes
+    ThreadAttributes::ContentionScope scope = ThreadAttributes::SCOPE_SYSTEM;
+    int remaining_ms;          // Burst still to run
+    long long vruntime = 0;    // Weighted run time, used to share the CPU fairly under OTHER
+    unsigned long sequence = 0; // Queue order within a priority level
+    bool started = false;
+    int wcet_ms = 0;     // POLICY_DEADLINE parameters, see ThreadAttributes
+    int deadline_ms = 0;
+    int period_ms = 0;
+    std::chrono::steady_clock::time_point absolute_deadline;
     std::chrono::steady_clock::time_point arrival_time;
     std::chrono::steady_clock::time_point start_time;
     std::chrono::steady_clock::time_point completion_time;
     
     ThreadInfo(int id, int prio, int burst) 
-        : thread_id(id), priority(prio), burst_time(burst) {
+        : thread_id(id), priority(prio), burst_time(burst), remaining_ms(burst * 100) {
         arrival_time = std::chrono::steady_clock::now();
     }
     
+    ThreadInfo(int id, int burst, const ThreadAttributes& attr)
+        : ThreadInfo(id, attr.priority, burst) {
+        policy = attr.policy;
+        scope = attr.scope;
+        preemptible = true;
+        if (hasDeadline()) {
+            wcet_ms = attr.runtime_ms;
+            deadline_ms = attr.deadline_ms;
+            period_ms = attr.period_ms;
+            absolute_deadline = arrival_time + std::chrono::milliseconds(deadline_ms);
+        }
+    }
+    
+    bool isRealTime() const {
+        return policy != ThreadAttributes::POLICY_OTHER;
+    }
+    
+    bool hasDeadline() const {
+        return policy == ThreadAttributes::POLICY_DEADLINE;
+    }
+    
+    // CPU share reserved for the thread by admission control
+    double density() const {
+        return static_cast<double>(wcet_ms) / std::max(std::min(deadline_ms, period_ms), 1);
+    }
+    
     // Copy constructor
     ThreadInfo(const ThreadInfo& other) = default;
     
@@ -33,36 +135,652 @@ public:
     ThreadInfo& operator=(const ThreadInfo& other) = default;
 };
 
-// Custom comparator for priority queue
+// Custom comparator for priority queue: true when a should run after b.
+// Deadline threads beat everything else, earliest absolute deadline first.
+// Real-time threads (FIFO/RR) beat OTHER; among them higher priority
+// wins, then queue order. OTHER threads are ordered by weighted run time.
 struct ThreadComparator {
     bool operator()(const ThreadInfo& a, const ThreadInfo& b) const {
-        // Higher priority number = higher priority (reverse comparison for max heap)
-        return a.priority < b.priority;
+        if (a.hasDeadline() != b.hasDeadline()) {
+            return !a.hasDeadline();
+        }
+        if (a.hasDeadline() && a.absolute_deadline != b.absolute_deadline) {
+            return a.absolute_deadline > b.absolute_deadline;
+        }
+        if (a.isRealTime() != b.isRealTime()) {
+            return !a.isRealTime();
+        }
+        if (a.isRealTime()) {
+            // Higher priority number = higher priority (reverse comparison for max heap)
+            if (a.priority != b.priority) return a.priority < b.priority;
+        } else if (a.vruntime != b.vruntime) {
+            return a.vruntime > b.vruntime;
+        }
+        return a.sequence > b.sequence;
+    }
+};
+
+#ifdef HAVE_COROUTINES
+class CoroutineRuntime;
+
+// Fire-and-forget coroutine owned by a CoroutineRuntime once spawned. It starts
+// suspended and stays suspended at the end so the runtime can reap it.
+class CoTask {
+public:
+    struct promise_type {
+        CoTask get_return_object() { return CoTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+    
+    explicit CoTask(std::coroutine_handle<promise_type> h) : handle(h) {}
+    CoTask(CoTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+    ~CoTask() { if (handle) handle.destroy(); }
+    
+    std::coroutine_handle<promise_type> release() { return std::exchange(handle, nullptr); }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Hashed timer wheel with 1 ms slots. A timer sits in the slot for its expiry
+// tick modulo the wheel size; timers more than one revolution out simply stay
+// put until the wheel comes round to their tick.
+class TimerWheel {
+public:
+    static constexpr size_t SLOTS = 1024;
+    
+    void schedule(uint64_t expiry_tick, std::coroutine_handle<> handle) {
+        expiry_tick = std::max(expiry_tick, current_tick + 1);
+        slots[expiry_tick % SLOTS].push_back({expiry_tick, handle});
+        pending++;
+    }
+    
+    // Moves every timer due at or before now_tick onto ready
+    void advance(uint64_t now_tick, std::deque<std::coroutine_handle<>>& ready) {
+        while (current_tick < now_tick && pending > 0) {
+            current_tick++;
+            auto& slot = slots[current_tick % SLOTS];
+            size_t kept = 0;
+            for (size_t i = 0; i < slot.size(); i++) {
+                if (slot[i].expiry <= current_tick) {
+                    ready.push_back(slot[i].handle);
+                    pending--;
+                } else {
+                    slot[kept++] = slot[i];
+                }
+            }
+            slot.resize(kept);
+        }
+        current_tick = std::max(current_tick, now_tick);
+    }
+    
+    // Earliest pending expiry; only meaningful when size() > 0
+    uint64_t nextExpiry() const {
+        uint64_t earliest = UINT64_MAX;
+        for (uint64_t tick = current_tick + 1; tick <= current_tick + SLOTS; tick++) {
+            for (const auto& timer : slots[tick % SLOTS]) {
+                earliest = std::min(earliest, timer.expiry);
+            }
+            if (earliest <= tick) break; // nothing later in the revolution can be earlier
+        }
+        return earliest;
     }
+    
+    size_t size() const { return pending; }
+
+private:
+    struct Timer {
+        uint64_t expiry;
+        std::coroutine_handle<> handle;
+    };
+    
+    std::vector<std::vector<Timer>> slots = std::vector<std::vector<Timer>>(SLOTS);
+    uint64_t current_tick = 0;
+    size_t pending = 0;
 };
 
+// Single-threaded coroutine executor: a FIFO of runnable coroutines plus a timer
+// wheel for the suspended ones. A coroutine that awaits a timer or simulated I/O
+// gives the thread back instead of blocking it.
+class CoroutineRuntime {
+public:
+    struct Stats {
+        size_t spawned = 0;
+        size_t resumes = 0;
+        size_t io_waits = 0;
+        size_t peak_suspended = 0;
+    };
+    
+    CoroutineRuntime() : epoch(std::chrono::steady_clock::now()) {}
+    
+    ~CoroutineRuntime() {
+        // Coroutines still parked here never finished; free their frames
+        for (auto handle : ready) handle.destroy();
+    }
+    
+    void spawn(CoTask task) {
+        ready.push_back(task.release());
+        live++;
+        stats.spawned++;
+    }
+    
+    uint64_t nowTick() const {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - epoch).count());
+    }
+    
+    struct TimerAwaiter {
+        CoroutineRuntime& runtime;
+        uint64_t delay_ms;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            runtime.timers.schedule(runtime.nowTick() + delay_ms, handle);
+            runtime.stats.peak_suspended = std::max(runtime.stats.peak_suspended, runtime.timers.size());
+        }
+        void await_resume() const noexcept {}
+    };
+    
+    struct YieldAwaiter {
+        CoroutineRuntime& runtime;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { runtime.ready.push_back(handle); }
+        void await_resume() const noexcept {}
+    };
+    
+    // co_await runtime.sleepFor(ms): resume after ms milliseconds
+    TimerAwaiter sleepFor(uint64_t ms) { return TimerAwaiter{*this, ms}; }
+    
+    // co_await runtime.simulatedIO(ms): an I/O request that completes after ms milliseconds
+    TimerAwaiter simulatedIO(uint64_t ms) {
+        stats.io_waits++;
+        return TimerAwaiter{*this, ms};
+    }
+    
+    // co_await runtime.yield(): let every other runnable coroutine go first
+    YieldAwaiter yield() { return YieldAwaiter{*this}; }
+    
+    // Runs until every spawned coroutine has finished, sleeping the thread only
+    // when nothing is runnable and the next timer is still in the future
+    void run() {
+        while (live > 0) {
+            timers.advance(nowTick(), ready);
+            if (ready.empty()) {
+                uint64_t next = timers.nextExpiry();
+                if (next == UINT64_MAX) break; // everything left is blocked forever
+                std::this_thread::sleep_until(epoch + std::chrono::milliseconds(next));
+                continue;
+            }
+            
+            // Run the current batch; anything it wakes or yields goes behind it
+            for (size_t batch = ready.size(); batch > 0; batch--) {
+                auto handle = ready.front();
+                ready.pop_front();
+                handle.resume();
+                stats.resumes++;
+                if (handle.done()) {
+                    handle.destroy();
+                    live--;
+                }
+            }
+        }
+    }
+    
+    const Stats& getStats() const { return stats; }
+
+private:
+    std::chrono::steady_clock::time_point epoch;
+    std::deque<std::coroutine_handle<>> ready;
+    TimerWheel timers;
+    size_t live = 0;
+    Stats stats;
+};
+#endif
+
 class ThreadScheduler {
+public:
+    // Upper edges of the deadline lateness histogram buckets in ms; the first
+    // bucket holds threads that met their deadline, the last everything later
+    static constexpr int LATENESS_BUCKETS_MS[5] = {0, 10, 50, 100, 500};
+    
+    struct PolicyStats {
+        int threads = 0;
+        long long total_response_ms = 0;  // Arrival to first run
+        long long max_response_ms = 0;
+        long long total_turnaround_ms = 0;
+        int preemptions = 0;
+        // POLICY_DEADLINE only
+        int deadline_misses = 0;
+        long long max_lateness_ms = LLONG_MIN;
+        int lateness_histogram[6] = {};
+    };
+    
 private:
+    // What a scheduler() worker is running, so a newly arrived real-time thread
+    // can preempt it mid-slice
+    struct WorkerSlot {
+        const ThreadInfo* running = nullptr;
+        bool preempt = false;
+    };
+    
     std::priority_queue<ThreadInfo, std::vector<ThreadInfo>, ThreadComparator> ready_queue;
     std::mutex queue_mutex;
     std::condition_variable cv;
+    std::condition_variable slice_cv; // Cut a running slice short for preemption
     std::atomic<bool> running{true};
     std::atomic<int> submitted_threads{0};
     std::atomic<int> completed_threads{0};
+    std::list<WorkerSlot> worker_slots;
+    unsigned long next_sequence = 0;
+    long long min_vruntime = 0;
+    int quantum_ms = 100;
+    std::atomic<bool> apply_os_policy{false};
+    PolicyStats policy_stats[ThreadAttributes::POLICY_COUNT];
+    // Admission control for POLICY_DEADLINE: density reserved by each admitted
+    // thread until it completes, keyed by thread_id
+    std::vector<std::pair<int, double>> deadline_reservations;
+    bool verbose = true;
+    
+    // Sharded ready queue (enableShardedQueue): one small heap per worker instead
+    // of the single queue_mutex-protected ready_queue. Dispatch is relaxed: a
+    // worker samples two shards and takes the better head.
+    struct alignas(64) Shard {
+        std::mutex mtx;
+        std::priority_queue<ThreadInfo, std::vector<ThreadInfo>, ThreadComparator> heap;
+        std::atomic<uint64_t> top_rank{0}; // rankOf(heap.top()), 0 when empty
+        std::atomic<int> size{0};
+        long long min_vruntime = 0;
+        PolicyStats stats[ThreadAttributes::POLICY_COUNT];
+    };
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<int> next_worker{0};
+    
+    // A parked sharded worker; lives on the worker's stack while it waits.
+    // Parking is per worker, so any number of workers can share a shard.
+    struct Sleeper {
+        int home;                   // The worker's own shard
+        std::condition_variable cv;
+        bool woken = false;         // Guarded by sleep_mutex
+    };
+    std::mutex sleep_mutex;
+    std::vector<Sleeper*> sleepers; // Parked workers, guarded by sleep_mutex
+    std::atomic<int> sleeper_count{0};
+    std::atomic<unsigned long> shard_sequence{0};
+    
+    // ThreadComparator order squeezed into one integer (higher runs first) so a
+    // shard's head can be sampled without taking its lock
+    static uint64_t rankOf(const ThreadInfo& t) {
+        if (t.hasDeadline()) {
+            constexpr uint64_t LOW_BITS = (1ULL << 62) - 1;
+            uint64_t due = static_cast<uint64_t>(std::max<long long>(0,
+                std::chrono::duration_cast<std::chrono::microseconds>(t.absolute_deadline.time_since_epoch()).count()));
+            return (3ULL << 62) | (LOW_BITS - std::min(due, LOW_BITS));
+        }
+        if (t.isRealTime()) {
+            uint64_t priority = static_cast<uint64_t>(std::clamp(t.priority, 0, 0x3FFFFFFF));
+            return (1ULL << 63) | (priority << 32) | (0xFFFFFFFFULL - (t.sequence & 0xFFFFFFFFULL));
+        }
+        uint64_t vruntime = static_cast<uint64_t>(std::clamp<long long>(t.vruntime, 0, (1LL << 62)));
+        return (1ULL << 62) - vruntime + 1;
+    }
+    
+    static std::minstd_rand& shardRandom() {
+        thread_local std::minstd_rand gen(std::random_device{}());
+        return gen;
+    }
+    
+    void pushShard(Shard& shard, ThreadInfo thread_info) {
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        if (!thread_info.isRealTime()) {
+            thread_info.vruntime = std::max(thread_info.vruntime, shard.min_vruntime);
+        }
+        shard.heap.push(thread_info);
+        shard.size.fetch_add(1, std::memory_order_relaxed);
+        shard.top_rank.store(rankOf(shard.heap.top()));
+    }
+    
+    bool popShard(Shard& shard, ThreadInfo& out) {
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        if (shard.heap.empty()) return false;
+        out = shard.heap.top();
+        shard.heap.pop();
+        shard.size.fetch_sub(1, std::memory_order_relaxed);
+        // OTHER threads leave the heap smallest vruntime first, so this tracks the
+        // shard's runnable minimum monotonically, as min_vruntime does in the strict path
+        if (!out.isRealTime()) {
+            shard.min_vruntime = std::max(shard.min_vruntime, out.vruntime);
+        }
+        shard.top_rank.store(shard.heap.empty() ? 0 : rankOf(shard.heap.top()));
+        return true;
+    }
+    
+    // Power of two choices: compare the heads of two random shards and pop the
+    // better one. Falls back to a full scan so an almost-empty system still drains.
+    bool popSharded(int worker, ThreadInfo& out) {
+        int n = static_cast<int>(shards.size());
+        auto& gen = shardRandom();
+        for (int attempt = 0; attempt < 4; attempt++) {
+            int a = static_cast<int>(gen() % n);
+            int b = static_cast<int>(gen() % n);
+            uint64_t rank_a = shards[a]->top_rank.load(std::memory_order_relaxed);
+            uint64_t rank_b = shards[b]->top_rank.load(std::memory_order_relaxed);
+            if (rank_a == 0 && rank_b == 0) break;
+            if (popShard(*shards[rank_a >= rank_b ? a : b], out)) return true;
+        }
+        for (int k = 0; k < n; k++) {
+            Shard& shard = *shards[(worker + k) % n];
+            if (shard.top_rank.load() != 0 && popShard(shard, out)) return true;
+        }
+        return false;
+    }
+    
+    bool anyShardNonEmpty() const {
+        for (const auto& shard : shards) {
+            if (shard->top_rank.load() != 0) return true;
+        }
+        return false;
+    }
+    
+    // Targeted wakeup: wake a parked worker whose own shard just received work,
+    // otherwise exactly one other parked worker. No lock while nobody is parked.
+    void wakeOneWorker(int target) {
+        if (sleeper_count.load() == 0) return; // seq_cst: pairs with the worker's announcement
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        if (sleepers.empty()) return;
+        auto it = std::find_if(sleepers.begin(), sleepers.end(),
+                               [target](const Sleeper* sleeper) { return sleeper->home == target; });
+        if (it == sleepers.end()) it = sleepers.begin();
+        Sleeper* chosen = *it;
+        sleepers.erase(it);
+        sleeper_count.fetch_sub(1);
+        chosen->woken = true;
+        chosen->cv.notify_one(); // Under the lock: the sleeper may return as soon as it is released
+    }
+    
+    // Takes a sleeper off the parked list unless a waker already did
+    void unpark(Sleeper& self) {
+        if (self.woken) return;
+        sleepers.erase(std::find(sleepers.begin(), sleepers.end(), &self));
+        sleeper_count.fetch_sub(1);
+    }
+    
+    void shardedWorker() {
+        int worker = next_worker.fetch_add(1);
+        int n = static_cast<int>(shards.size());
+        Shard& own = *shards[worker % n];
+        
+        while (true) {
+            ThreadInfo current_thread(0, 0, 0);
+            if (!popSharded(worker, current_thread)) {
+                // Announce the sleep before the final check so a concurrent
+                // addThread either sees us parked or we see its thread
+                Sleeper self;
+                self.home = worker % n;
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex);
+                    sleepers.push_back(&self);
+                    sleeper_count.fetch_add(1);
+                }
+                if (anyShardNonEmpty() || !running.load()) {
+                    {
+                        std::lock_guard<std::mutex> lock(sleep_mutex);
+                        unpark(self);
+                    }
+                    if (!running.load() && !anyShardNonEmpty()) break;
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                self.cv.wait(lock, [&] { return self.woken || !running.load(); });
+                unpark(self);
+                continue;
+            }
+            
+            auto now = std::chrono::steady_clock::now();
+            if (!current_thread.started) {
+                current_thread.started = true;
+                current_thread.start_time = now;
+            }
+            if (verbose) {
+                std::cout << "Executing Thread " << current_thread.thread_id 
+                          << " (Priority: " << current_thread.priority << ", "
+                          << ThreadAttributes::policyName(current_thread.policy) << ")\n";
+            }
+            
+            // No mid-slice preemption in this mode; a slice always runs out
+            int slice_ms = runsToCompletion(current_thread)
+                         ? current_thread.remaining_ms : std::min(quantum_ms, current_thread.remaining_ms);
+            if (slice_ms > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(slice_ms));
+            }
+            current_thread.remaining_ms -= slice_ms;
+            if (!current_thread.isRealTime()) {
+                current_thread.vruntime += slice_ms * 1024LL / fairWeight(current_thread.priority);
+            }
+            
+            if (current_thread.remaining_ms > 0) {
+                current_thread.sequence = shard_sequence.fetch_add(1, std::memory_order_relaxed);
+                pushShard(own, current_thread);
+                continue;
+            }
+            
+            current_thread.completion_time = std::chrono::steady_clock::now();
+            auto turnaround_time = std::chrono::duration_cast<std::chrono::milliseconds>
+                (current_thread.completion_time - current_thread.arrival_time);
+            {
+                std::lock_guard<std::mutex> lock(own.mtx);
+                PolicyStats& stats = own.stats[current_thread.policy];
+                long long response = std::chrono::duration_cast<std::chrono::milliseconds>
+                    (current_thread.start_time - current_thread.arrival_time).count();
+                stats.threads++;
+                stats.total_response_ms += response;
+                stats.max_response_ms = std::max(stats.max_response_ms, response);
+                stats.total_turnaround_ms += turnaround_time.count();
+                if (current_thread.hasDeadline()) {
+                    recordLateness(stats, current_thread);
+                }
+            }
+            if (current_thread.hasDeadline()) {
+                releaseReservation(current_thread.thread_id);
+            }
+            if (verbose) {
+                std::cout << "Thread " << current_thread.thread_id 
+                          << " completed. Turnaround time: " << turnaround_time.count() << "ms\n";
+            }
+            completed_threads.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (verbose) {
+            std::cout << "Scheduler stopped. Total threads completed: " << completed_threads.load() << "\n";
+        }
+    }
+    
+    // Relative CPU share of an OTHER thread: each priority level adds a quarter share
+    static long long fairWeight(int priority) {
+        return 1024 + 256 * std::max(priority, 0);
+    }
+    
+    // Whether a newly runnable thread should take the CPU from a running one
+    static bool preempts(const ThreadInfo& incoming, const ThreadInfo& current) {
+        if (!current.preemptible) return false;
+        if (incoming.hasDeadline()) {
+            return !current.hasDeadline() || incoming.absolute_deadline < current.absolute_deadline;
+        }
+        if (current.hasDeadline()) return false;
+        return incoming.isRealTime() && (!current.isRealTime() || incoming.priority > current.priority);
+    }
+    
+    // FIFO and deadline threads keep the CPU until they finish or are preempted
+    static bool runsToCompletion(const ThreadInfo& thread_info) {
+        return thread_info.policy == ThreadAttributes::POLICY_FIFO || thread_info.hasDeadline();
+    }
+    
+    static void recordLateness(PolicyStats& stats, const ThreadInfo& thread_info) {
+        long long lateness = std::chrono::duration_cast<std::chrono::milliseconds>
+            (thread_info.completion_time - thread_info.absolute_deadline).count();
+        int bucket = 0;
+        while (bucket < 5 && lateness > LATENESS_BUCKETS_MS[bucket]) bucket++;
+        stats.lateness_histogram[bucket]++;
+        if (lateness > 0) stats.deadline_misses++;
+        stats.max_lateness_ms = std::max(stats.max_lateness_ms, lateness);
+    }
+    
+    // Global EDF admission (Goossens, Funk & Baruah): a deadline thread set is
+    // schedulable on m workers if its total density stays within
+    // m - (m - 1) * largest density. Caller holds queue_mutex.
+    bool admitLocked(const ThreadInfo& thread_info) {
+        double total = thread_info.density();
+        double largest = thread_info.density();
+        for (const auto& reservation : deadline_reservations) {
+            total += reservation.second;
+            largest = std::max(largest, reservation.second);
+        }
+        int workers = std::max<int>(shards.empty() ? worker_slots.size() : shards.size(), 1);
+        if (largest > 1.0 || total > workers - (workers - 1) * largest) {
+            return false;
+        }
+        deadline_reservations.emplace_back(thread_info.thread_id, thread_info.density());
+        return true;
+    }
+    
+    void releaseReservationLocked(int thread_id) {
+        auto it = std::find_if(deadline_reservations.begin(), deadline_reservations.end(),
+                               [thread_id](const auto& reservation) { return reservation.first == thread_id; });
+        if (it != deadline_reservations.end()) deadline_reservations.erase(it);
+    }
+    
+    void releaseReservation(int thread_id) {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        releaseReservationLocked(thread_id);
+    }
+    
+    // Mirror the simulated policy onto the worker's OS thread. Gives up (once,
+    // with a message) when the kernel refuses, e.g. without CAP_SYS_NICE.
+    // Deadline threads get SCHED_FIFO at the top priority: SCHED_DEADLINE itself
+    // needs sched_setattr and is not available through pthreads.
+    void applyOSPolicy(const ThreadInfo& thread_info) {
+        int policy = thread_info.policy == ThreadAttributes::POLICY_FIFO ? SCHED_FIFO
+                   : thread_info.policy == ThreadAttributes::POLICY_RR ? SCHED_RR
+                   : thread_info.hasDeadline() ? SCHED_FIFO : SCHED_OTHER;
+        sched_param param{};
+        if (thread_info.hasDeadline()) {
+            param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+        } else if (policy != SCHED_OTHER) {
+            param.sched_priority = std::clamp(thread_info.priority, sched_get_priority_min(policy),
+                                              sched_get_priority_max(policy));
+        }
+        int rc = pthread_setschedparam(pthread_self(), policy, &param);
+        if (rc != 0 && apply_os_policy.exchange(false)) {
+            std::cerr << "pthread_setschedparam: " << std::strerror(rc)
+                      << " - continuing with simulated policies only\n";
+        }
+    }
     
 public:
     ThreadScheduler() = default;
     
-    void addThread(const ThreadInfo& thread_info) {
+    // Switch to the sharded ready queue with one shard per worker. Call before
+    // starting workers or adding threads. Relaxed: a dispatch may pick a thread
+    // that is not the global best, and running threads are not preempted.
+    void enableShardedQueue(int shard_count) {
+        shards.clear();
+        for (int i = 0; i < std::max(shard_count, 1); i++) {
+            shards.push_back(std::make_unique<Shard>());
+        }
+    }
+    
+    void setVerbose(bool enabled) {
+        verbose = enabled;
+    }
+    
+    // Time slice for RR and OTHER threads; FIFO threads ignore it
+    void setTimeQuantum(int ms) {
+        quantum_ms = std::max(ms, 1);
+    }
+    
+    // Also apply each thread's policy to the OS thread running it via
+    // pthread_setschedparam, where the process is permitted to
+    void setApplyOSPolicy(bool apply) {
+        apply_os_policy = apply;
+    }
+    
+    // Returns false if a POLICY_DEADLINE thread fails admission control (see
+    // admitLocked; counts the workers started so far) and was not queued
+    bool addThread(const ThreadInfo& thread_info) {
+        if (thread_info.hasDeadline()) {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            if (!admitLocked(thread_info)) {
+                if (verbose) {
+                    std::cout << "Thread " << thread_info.thread_id << " rejected by deadline admission control\n";
+                }
+                return false;
+            }
+        }
+        
+        if (!shards.empty()) {
+            // Two random shards, the shorter one gets the thread
+            auto& gen = shardRandom();
+            int n = static_cast<int>(shards.size());
+            int a = static_cast<int>(gen() % n);
+            int b = static_cast<int>(gen() % n);
+            int target = shards[a]->size.load(std::memory_order_relaxed) <=
+                         shards[b]->size.load(std::memory_order_relaxed) ? a : b;
+            ThreadInfo queued = thread_info;
+            queued.sequence = shard_sequence.fetch_add(1, std::memory_order_relaxed);
+            submitted_threads++;
+            pushShard(*shards[target], queued);
+            wakeOneWorker(target);
+            return true;
+        }
+        
+        bool preempting = false;
         {
             std::lock_guard<std::mutex> lock(queue_mutex);
-            ready_queue.push(thread_info);
+            ThreadInfo queued = thread_info;
+            queued.sequence = next_sequence++;
+            // A newcomer starts level with the fairest runnable thread instead of at zero
+            queued.vruntime = std::max(queued.vruntime, min_vruntime);
+            ready_queue.push(queued);
             submitted_threads++;
+            
+            // Preempt the worker running the least important thread, if the newcomer
+            // outranks it - but only when no idle worker is left to pick the newcomer up
+            size_t idle_workers = 0;
+            for (const auto& slot : worker_slots) {
+                if (!slot.running) idle_workers++;
+            }
+            WorkerSlot* victim = nullptr;
+            for (auto& slot : worker_slots) {
+                if (idle_workers >= ready_queue.size()) break;
+                if (slot.running && !slot.preempt && preempts(queued, *slot.running) &&
+                    (!victim || ThreadComparator()(*slot.running, *victim->running))) {
+                    victim = &slot;
+                }
+            }
+            if (victim) {
+                victim->preempt = true;
+                preempting = true;
+            }
         }
         cv.notify_one();
+        if (preempting) slice_cv.notify_all();
+        return true;
     }
     
     void scheduler() {
+        if (!shards.empty()) {
+            shardedWorker();
+            return;
+        }
+        
+        std::list<WorkerSlot>::iterator slot;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            slot = worker_slots.emplace(worker_slots.end());
+        }
+        
         while (true) {
             std::unique_lock<std::mutex> lock(queue_mutex);
             
@@ -73,42 +791,150 @@ public:
             
             // Check if we should exit
             if (!running.load() && ready_queue.empty()) {
+                worker_slots.erase(slot);
                 break;
             }
             
-            if (!ready_queue.empty()) {
-                ThreadInfo current_thread = ready_queue.top();
-                ready_queue.pop();
-                lock.unlock();
-                
-                // Simulate thread execution
+            if (ready_queue.empty()) continue;
+            
+            ThreadInfo current_thread = ready_queue.top();
+            ready_queue.pop();
+            PolicyStats& stats = policy_stats[current_thread.policy];
+            if (!current_thread.started) {
+                current_thread.started = true;
                 current_thread.start_time = std::chrono::steady_clock::now();
+                long long response = std::chrono::duration_cast<std::chrono::milliseconds>
+                    (current_thread.start_time - current_thread.arrival_time).count();
+                stats.total_response_ms += response;
+                stats.max_response_ms = std::max(stats.max_response_ms, response);
+            }
+            if (!current_thread.isRealTime()) {
+                min_vruntime = std::max(min_vruntime, current_thread.vruntime);
+            }
+            int slice_ms = runsToCompletion(current_thread)
+                         ? current_thread.remaining_ms : std::min(quantum_ms, current_thread.remaining_ms);
+            slot->running = &current_thread;
+            slot->preempt = false;
+            lock.unlock();
+            
+            if (apply_os_policy.load()) {
+                applyOSPolicy(current_thread);
+            }
+            if (verbose) {
                 std::cout << "Executing Thread " << current_thread.thread_id 
-                          << " (Priority: " << current_thread.priority << ")\n";
-                
-                std::this_thread::sleep_for(std::chrono::milliseconds(current_thread.burst_time * 100));
-                
-                current_thread.completion_time = std::chrono::steady_clock::now();
-                
-                auto turnaround_time = std::chrono::duration_cast<std::chrono::milliseconds>
-                    (current_thread.completion_time - current_thread.arrival_time);
-                
+                          << " (Priority: " << current_thread.priority << ", "
+                          << ThreadAttributes::policyName(current_thread.policy) << ")\n";
+            }
+            
+            // Simulate thread execution for one slice, unless something preempts it.
+            // An empty slice skips the timed wait, as the sharded path does.
+            lock.lock();
+            auto slice_start = std::chrono::steady_clock::now();
+            bool preempted = slice_ms > 0 &&
+                             slice_cv.wait_until(lock, slice_start + std::chrono::milliseconds(slice_ms),
+                                                 [&] { return slot->preempt; });
+            int ran_ms = std::min(slice_ms, static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>
+                (std::chrono::steady_clock::now() - slice_start).count()));
+            slot->running = nullptr;
+            current_thread.remaining_ms -= ran_ms;
+            if (!current_thread.isRealTime()) {
+                current_thread.vruntime += ran_ms * 1024LL / fairWeight(current_thread.priority);
+            }
+            
+            if (current_thread.remaining_ms > 0) {
+                // A preempted thread keeps its place at the head of its level;
+                // one whose RR/OTHER slice ran out goes to the back
+                if (preempted) {
+                    stats.preemptions++;
+                } else {
+                    current_thread.sequence = next_sequence++;
+                }
+                ready_queue.push(current_thread);
+                lock.unlock();
+                if (preempted && verbose) {
+                    std::cout << "Thread " << current_thread.thread_id << " preempted with "
+                              << current_thread.remaining_ms << "ms left\n";
+                }
+                continue;
+            }
+            
+            current_thread.completion_time = std::chrono::steady_clock::now();
+            
+            auto turnaround_time = std::chrono::duration_cast<std::chrono::milliseconds>
+                (current_thread.completion_time - current_thread.arrival_time);
+            stats.threads++;
+            stats.total_turnaround_ms += turnaround_time.count();
+            if (current_thread.hasDeadline()) {
+                recordLateness(stats, current_thread);
+                releaseReservationLocked(current_thread.thread_id);
+            }
+            lock.unlock();
+            
+            if (verbose) {
                 std::cout << "Thread " << current_thread.thread_id 
                           << " completed. Turnaround time: " << turnaround_time.count() << "ms\n";
-                
-                // Update completed counter
-                completed_threads++;
-                
-                // Notify waiters
-                cv.notify_all();
             }
+            
+            // Update completed counter
+            completed_threads++;
+            
+            // Notify waiters
+            cv.notify_all();
+        }
+        if (verbose) {
+            std::cout << "Scheduler stopped. Total threads completed: " << completed_threads.load() << "\n";
         }
-        std::cout << "Scheduler stopped. Total threads completed: " << completed_threads.load() << "\n";
+    }
+    
+    // Completed-thread statistics for one policy, across all shards
+    PolicyStats policyStats(ThreadAttributes::SchedulingPolicy policy) {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        PolicyStats stats = policy_stats[policy];
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> shard_lock(shard->mtx);
+            const PolicyStats& part = shard->stats[policy];
+            stats.threads += part.threads;
+            stats.total_response_ms += part.total_response_ms;
+            stats.max_response_ms = std::max(stats.max_response_ms, part.max_response_ms);
+            stats.total_turnaround_ms += part.total_turnaround_ms;
+            stats.deadline_misses += part.deadline_misses;
+            stats.max_lateness_ms = std::max(stats.max_lateness_ms, part.max_lateness_ms);
+            for (int i = 0; i < 6; i++) stats.lateness_histogram[i] += part.lateness_histogram[i];
+        }
+        return stats;
+    }
+    
+    void displayPolicyStats() {
+        std::cout << "\n=== PER-POLICY LATENCY ===\n";
+        std::cout << "Policy        Threads  Avg Response  Max Response  Avg Turnaround  Preemptions\n";
+        for (auto policy : {ThreadAttributes::POLICY_DEADLINE, ThreadAttributes::POLICY_FIFO,
+                            ThreadAttributes::POLICY_RR, ThreadAttributes::POLICY_OTHER}) {
+            PolicyStats stats = policyStats(policy);
+            if (stats.threads == 0) continue;
+            std::printf("%-12s  %7d  %10lldms  %10lldms  %12lldms  %11d\n", ThreadAttributes::policyName(policy),
+                        stats.threads, stats.total_response_ms / stats.threads, stats.max_response_ms,
+                        stats.total_turnaround_ms / stats.threads, stats.preemptions);
+        }
+        
+        PolicyStats deadline = policyStats(ThreadAttributes::POLICY_DEADLINE);
+        if (deadline.threads == 0) return;
+        std::printf("Deadline misses: %d of %d, max lateness %lldms\nLateness: on time %d", deadline.deadline_misses,
+                    deadline.threads, deadline.max_lateness_ms, deadline.lateness_histogram[0]);
+        for (int i = 1; i < 6; i++) {
+            if (i < 5) std::printf(", %d-%dms %d", LATENESS_BUCKETS_MS[i - 1], LATENESS_BUCKETS_MS[i],
+                                   deadline.lateness_histogram[i]);
+            else std::printf(", >%dms %d", LATENESS_BUCKETS_MS[4], deadline.lateness_histogram[i]);
+        }
+        std::printf("\n");
     }
     
     void stop() {
         running.store(false);
         cv.notify_all();
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        for (Sleeper* sleeper : sleepers) {
+            sleeper->cv.notify_one();
+        }
     }
     
     void waitForCompletion() {
@@ -128,30 +954,86 @@ public:
     int getSubmittedThreadsCount() const {
         return submitted_threads.load();
     }
-};
-
-// Pthread-style thread attributes simulation with custom enum names
-class ThreadAttributes {
-public:
-    // Use custom names to avoid conflicts with system constants
-    enum SchedulingPolicy { POLICY_FIFO, POLICY_RR, POLICY_OTHER };
-    enum ContentionScope { SCOPE_PROCESS, SCOPE_SYSTEM };
-    
-    SchedulingPolicy policy = POLICY_OTHER;
-    ContentionScope scope = SCOPE_SYSTEM;
-    int priority = 0;
     
-    void setSchedulingPolicy(SchedulingPolicy pol) { policy = pol; }
-    void setContentionScope(ContentionScope sc) { scope = sc; }
-    void setPriority(int prio) { priority = prio; }
-    
-    void displayAttributes() const {
-        std::cout << "Thread Attributes:\n";
-        std::cout << "  Policy: " << (policy == POLICY_FIFO ? "FIFO" : 
-                                    policy == POLICY_RR ? "Round Robin" : "Other") << "\n";
-        std::cout << "  Scope: " << (scope == SCOPE_PROCESS ? "Process" : "System") << "\n";
-        std::cout << "  Priority: " << priority << "\n";
+#ifdef HAVE_COROUTINES
+    // Coroutine execution mode: drains the ready queue in priority order and runs
+    // each thread as a coroutine on one of `workers` OS threads. A thread's burst
+    // becomes burst_time simulated I/O waits of 100ms each, so the OS thread is
+    // free for other coroutines while it waits instead of sleeping in sleep_for.
+    void runAsCoroutines(int workers = 1, bool show_threads = true) {
+        std::vector<ThreadInfo> threads;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            while (!ready_queue.empty()) {
+                threads.push_back(ready_queue.top());
+                ready_queue.pop();
+            }
+        }
+        for (auto& shard : shards) {
+            ThreadInfo thread_info(0, 0, 0);
+            while (popShard(*shard, thread_info)) {
+                threads.push_back(thread_info);
+            }
+        }
+        
+        workers = std::max(workers, 1);
+        std::atomic<long long> total_turnaround{0};
+        std::vector<CoroutineRuntime::Stats> stats(workers);
+        auto start = std::chrono::steady_clock::now();
+        
+        std::vector<std::thread> pool;
+        for (int w = 0; w < workers; w++) {
+            pool.emplace_back([&, w]() {
+                CoroutineRuntime runtime;
+                // Deal threads out round-robin so each worker keeps the priority order
+                for (size_t i = w; i < threads.size(); i += workers) {
+                    runtime.spawn(threadCoroutine(runtime, threads[i], total_turnaround, show_threads));
+                }
+                runtime.run();
+                stats[w] = runtime.getStats();
+            });
+        }
+        for (auto& t : pool) t.join();
+        
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        size_t peak = 0, resumes = 0;
+        for (const auto& s : stats) {
+            peak += s.peak_suspended;
+            resumes += s.resumes;
+        }
+        std::cout << "Coroutine mode: " << threads.size() << " threads on " << workers
+                  << " OS thread(s) finished in " << elapsed.count() << "ms\n";
+        if (!threads.empty()) {
+            std::cout << "  Average turnaround: " << total_turnaround.load() / static_cast<long long>(threads.size())
+                      << "ms, peak suspended at once: " << peak << ", resumes: " << resumes << "\n";
+        }
+    }
+
+private:
+    CoTask threadCoroutine(CoroutineRuntime& runtime, ThreadInfo current_thread,
+                           std::atomic<long long>& total_turnaround, bool show_threads) {
+        current_thread.start_time = std::chrono::steady_clock::now();
+        if (show_threads) {
+            std::cout << "Executing Thread " << current_thread.thread_id 
+                      << " (Priority: " << current_thread.priority << ") as a coroutine\n";
+        }
+        
+        for (int unit = 0; unit < current_thread.burst_time; unit++) {
+            co_await runtime.simulatedIO(100);
+        }
+        
+        current_thread.completion_time = std::chrono::steady_clock::now();
+        auto turnaround_time = std::chrono::duration_cast<std::chrono::milliseconds>
+            (current_thread.completion_time - current_thread.arrival_time);
+        total_turnaround += turnaround_time.count();
+        if (show_threads) {
+            std::cout << "Thread " << current_thread.thread_id 
+                      << " completed. Turnaround time: " << turnaround_time.count() << "ms\n";
+        }
+        completed_threads++;
     }
+#endif
 };
 
 // Demo worker thread function
@@ -161,7 +1043,70 @@ void workerThread(int id, int work_time) {
     std::cout << "Worker Thread " << id << " completed work\n";
 }
 
-int main() {
+// Dispatch throughput of the strict single queue against the sharded one:
+// producers submit zero-length threads as fast as they can and the workers
+// drain them. Returns threads per second.
+double runReadyQueueBenchmark(int workers, bool sharded, int total) {
+    ThreadScheduler scheduler;
+    scheduler.setVerbose(false);
+    if (sharded) scheduler.enableShardedQueue(workers);
+    
+    std::vector<std::thread> worker_threads;
+    for (int i = 0; i < workers; i++) {
+        worker_threads.emplace_back(&ThreadScheduler::scheduler, &scheduler);
+    }
+    
+    const int producers = 4;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producer_threads;
+    for (int p = 0; p < producers; p++) {
+        producer_threads.emplace_back([&scheduler, p, total]() {
+            std::minstd_rand gen(p + 1);
+            for (int i = p; i < total; i += producers) {
+                scheduler.addThread(ThreadInfo(i, static_cast<int>(gen() % 10), 0));
+            }
+        });
+    }
+    for (auto& t : producer_threads) t.join();
+    while (scheduler.getCompletedThreadsCount() < total) {
+        std::this_thread::yield();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    scheduler.stop();
+    for (auto& t : worker_threads) t.join();
+    return total / seconds;
+}
+
+void benchmarkReadyQueues(int total) {
+    // Both paths skip the wait for a zero-length slice, so this measures queue
+    // overhead only; which one wins depends on the worker and CPU counts
+    std::cout << "Threads per run: " << total << ", 4 producers, " << std::thread::hardware_concurrency()
+              << " hardware threads\n\n";
+    std::cout << "Workers   Strict queue (thr/s)   Sharded 2-choice (thr/s)   Sharded/strict\n";
+    for (int workers : {1, 2, 4, 8, 16, 32, 64}) {
+        double strict = runReadyQueueBenchmark(workers, false, total);
+        double sharded = runReadyQueueBenchmark(workers, true, total);
+        std::printf("%7d   %20.0f   %24.0f   %13.2fx\n", workers, strict, sharded, sharded / strict);
+    }
+}
+
+// Usage: thread_scheduling [--os-policy]
+//        --os-policy also applies each thread's policy with pthread_setschedparam
+//        (needs CAP_SYS_NICE or a suitable RLIMIT_RTPRIO for FIFO/RR)
+//        thread_scheduling --bench [threads]
+//        compares the strict ready queue with the sharded one at 1-64 workers
+int main(int argc, char* argv[]) {
+    bool os_policy = argc > 1 && std::string(argv[1]) == "--os-policy";
+    
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        int total = argc > 2 ? std::atoi(argv[2]) : 200000;
+        std::cout << "Ready Queue Dispatch Benchmark\n";
+        std::cout << "==============================\n";
+        benchmarkReadyQueues(total);
+        return 0;
+    }
+    
     try {
         std::cout << "=== THREAD SCHEDULING DEMONSTRATION ===\n\n";
         
@@ -194,6 +1139,91 @@ int main() {
             scheduler_thread.join();
         }
         
+        std::cout << "\n=== POLICY-AWARE SCHEDULING ===\n";
+        
+        ThreadScheduler policy_scheduler;
+        policy_scheduler.setTimeQuantum(100);
+        policy_scheduler.setApplyOSPolicy(os_policy);
+        std::thread policy_thread(&ThreadScheduler::scheduler, &policy_scheduler);
+        
+        ThreadAttributes other_low, other_high, rr_attr, fifo_attr;
+        other_low.setSchedulingPolicy(ThreadAttributes::POLICY_OTHER);
+        other_low.setPriority(0);
+        other_high.setSchedulingPolicy(ThreadAttributes::POLICY_OTHER);
+        other_high.setPriority(4);
+        rr_attr.setSchedulingPolicy(ThreadAttributes::POLICY_RR);
+        rr_attr.setPriority(10);
+        fifo_attr.setSchedulingPolicy(ThreadAttributes::POLICY_FIFO);
+        fifo_attr.setPriority(20);
+        
+        policy_scheduler.addThread(ThreadInfo(11, 4, other_low));
+        policy_scheduler.addThread(ThreadInfo(12, 4, other_high));
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        // Latency-critical arrivals preempt the fair-share threads
+        policy_scheduler.addThread(ThreadInfo(13, 3, rr_attr));
+        policy_scheduler.addThread(ThreadInfo(14, 3, rr_attr));
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+        policy_scheduler.addThread(ThreadInfo(15, 2, fifo_attr));
+        
+        policy_scheduler.waitForCompletion();
+        policy_scheduler.stop();
+        if (policy_thread.joinable()) {
+            policy_thread.join();
+        }
+        policy_scheduler.displayPolicyStats();
+        
+        std::cout << "\n=== DEADLINE (EDF) THREADS ===\n";
+        
+        ThreadScheduler edf_scheduler;
+        std::vector<std::thread> edf_workers;
+        for (int i = 0; i < 2; i++) {
+            edf_workers.emplace_back(&ThreadScheduler::scheduler, &edf_scheduler);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Workers count towards admission
+        
+        // runtime/deadline/period in ms; a burst unit is 100ms of actual run time
+        ThreadAttributes tight, loose, hog;
+        tight.setSchedulingPolicy(ThreadAttributes::POLICY_DEADLINE);
+        tight.setDeadlineParams(100, 300, 1000);
+        loose.setSchedulingPolicy(ThreadAttributes::POLICY_DEADLINE);
+        loose.setDeadlineParams(300, 800, 1000);
+        hog.setSchedulingPolicy(ThreadAttributes::POLICY_DEADLINE);
+        hog.setDeadlineParams(900, 1000, 1000);
+        tight.displayAttributes();
+        
+        edf_scheduler.addThread(ThreadInfo(21, 3, loose));
+        edf_scheduler.addThread(ThreadInfo(22, 3, loose));
+        edf_scheduler.addThread(ThreadInfo(23, 1, tight));
+        edf_scheduler.addThread(ThreadInfo(24, 4, tight)); // Overruns its runtime and misses
+        edf_scheduler.addThread(ThreadInfo(25, 9, hog));   // Would exceed the EDF bound: rejected
+        edf_scheduler.addThread(ThreadInfo(26, 2, fifo_attr));
+        
+        edf_scheduler.waitForCompletion();
+        edf_scheduler.stop();
+        for (auto& worker : edf_workers) worker.join();
+        edf_scheduler.displayPolicyStats();
+        
+#ifdef HAVE_COROUTINES
+        std::cout << "\n=== COROUTINE EXECUTION MODE ===\n";
+        
+        ThreadScheduler coroutine_scheduler;
+        coroutine_scheduler.addThread(ThreadInfo(1, 3, 5));
+        coroutine_scheduler.addThread(ThreadInfo(2, 1, 3));
+        coroutine_scheduler.addThread(ThreadInfo(3, 5, 4));
+        coroutine_scheduler.addThread(ThreadInfo(4, 1, 2));
+        coroutine_scheduler.runAsCoroutines(1, true);
+        
+        // 100k concurrently "running" threads multiplexed onto a single OS thread
+        ThreadScheduler many_scheduler;
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<> prio_dist(1, 5);
+        std::uniform_int_distribution<> burst_dist(1, 5);
+        for (int i = 1; i <= 100000; i++) {
+            many_scheduler.addThread(ThreadInfo(i, prio_dist(gen), burst_dist(gen)));
+        }
+        many_scheduler.runAsCoroutines(1, false);
+#endif
+        
         std::cout << "\n=== PTHREAD STYLE THREADS ===\n";
         
         // Create multiple worker threads
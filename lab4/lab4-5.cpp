@@ -6,68 +6,633 @@
 #include <queue>
 #include <thread>
 #include <mutex>
-#include <condition_variable>
 #include <atomic>
 #include <chrono>
 #include <random>
 #include <algorithm>
 #include <climits>
+#include <cmath>
 #include <memory>
+#include <cstdint>
+#include <utility>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cctype>
+#include <cstring>
+#include <functional>
+#include <pthread.h>
+#include <sched.h>
+#include <deque>
+#include <cstdio>
+#include <cstdlib>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 class Task {
 public:
     int task_id;
     int burst_time;
     int preferred_cpu;
+    int home_node; // NUMA node holding the task's memory, -1 if it has none
+    std::function<void()> body; // Real work to run instead of sleeping for burst_time
     std::chrono::steady_clock::time_point arrival_time;
     std::chrono::steady_clock::time_point start_time;
     std::chrono::steady_clock::time_point completion_time;
     
-    Task(int id, int burst, int cpu = -1) 
-        : task_id(id), burst_time(burst), preferred_cpu(cpu) {
+    // Real-time parameters, all 0 for a best-effort task. A periodic task
+    // releases a job every period_ms, a sporadic one at least period_ms apart.
+    int period_ms = 0;
+    int wcet_ms = 0;     // Worst-case execution time of one job
+    int deadline_ms = 0; // Relative to the job's release
+    bool sporadic = false;
+    std::chrono::steady_clock::time_point absolute_deadline;
+    
+    Task(int id, int burst, int cpu = -1, int home = -1) 
+        : task_id(id), burst_time(burst), preferred_cpu(cpu), home_node(home) {
         arrival_time = std::chrono::steady_clock::now();
     }
+    
+    // A job runs for burst_time, which starts at the WCET and may be lowered to
+    // model typical rather than worst-case jobs. deadline 0 = implicit (the period).
+    static Task realTime(int id, int period, int wcet, int deadline = 0, bool is_sporadic = false) {
+        Task task(id, wcet);
+        task.period_ms = period;
+        task.wcet_ms = wcet;
+        task.deadline_ms = deadline > 0 ? deadline : period;
+        task.sporadic = is_sporadic;
+        return task;
+    }
+    
+    bool isRealTime() const {
+        return period_ms > 0;
+    }
+    
+    // Share of one CPU the task can demand before its deadline (its density;
+    // the utilization wcet / period for implicit deadlines)
+    double utilization() const {
+        return static_cast<double>(wcet_ms) / std::min(deadline_ms, period_ms);
+    }
+};
+
+enum class RealTimePolicy {
+    EDF, // Earliest absolute deadline first
+    RM   // Rate monotonic: shortest period first
+};
+
+// Heap order for real-time jobs: true when a should run after b
+struct RealTimeOrder {
+    RealTimePolicy policy = RealTimePolicy::EDF;
+    
+    bool operator()(const Task& a, const Task& b) const {
+        if (policy == RealTimePolicy::RM && a.period_ms != b.period_ms) {
+            return a.period_ms > b.period_ms;
+        }
+        if (a.absolute_deadline != b.absolute_deadline) {
+            return a.absolute_deadline > b.absolute_deadline;
+        }
+        return a.task_id > b.task_id;
+    }
+};
+
+// Chase-Lev work-stealing deque (Le et al., "Correct and Efficient Work-Stealing
+// for Weak Memory Models"). The owning thread pushes and pops at the bottom with
+// no atomic read-modify-write except when racing for the last element; other
+// threads steal from the top with a CAS. T must be trivially copyable.
+template <typename T>
+class WorkStealingDeque {
+private:
+    struct Buffer {
+        int64_t capacity;
+        std::unique_ptr<std::atomic<T>[]> slots;
+        
+        explicit Buffer(int64_t cap) : capacity(cap), slots(new std::atomic<T>[cap]) {}
+        
+        T get(int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t i, T value) { slots[i & (capacity - 1)].store(value, std::memory_order_relaxed); }
+    };
+    
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<Buffer*> buffer;
+    // Outgrown buffers stay alive until destruction, since a thief may still be reading one
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    
+    Buffer* grow(Buffer* old, int64_t t, int64_t b) {
+        buffers.push_back(std::make_unique<Buffer>(old->capacity * 2));
+        Buffer* bigger = buffers.back().get();
+        for (int64_t i = t; i < b; i++) {
+            bigger->put(i, old->get(i));
+        }
+        buffer.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+public:
+    explicit WorkStealingDeque(int64_t initial_capacity = 64) {
+        int64_t capacity = 1;
+        while (capacity < initial_capacity) capacity *= 2;
+        buffers.push_back(std::make_unique<Buffer>(capacity));
+        buffer.store(buffers.back().get(), std::memory_order_relaxed);
+    }
+    
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    
+    // Owner only
+    void push(T value) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1) {
+            a = grow(a, t, b);
+        }
+        a->put(b, value);
+        // Release publishes the slot to thieves, which read bottom with acquire
+        bottom.store(b + 1, std::memory_order_release);
+    }
+    
+    // Owner only: takes the most recently pushed element
+    bool pop(T& out) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = a->get(b);
+        if (t == b) {
+            // Last element: race the thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+    
+    // Any thread: takes the oldest element
+    bool steal(T& out) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return false;
+        
+        Buffer* a = buffer.load(std::memory_order_acquire);
+        T value = a->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+    
+    // Approximate; exact only when no other thread is operating on the deque
+    int64_t size() const {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_relaxed);
+        return std::max<int64_t>(b - t, 0);
+    }
+};
+
+// Thin wrappers over the Linux futex syscall: sleep while *word == expected,
+// and wake up to count sleepers on word
+static_assert(sizeof(std::atomic<int>) == sizeof(int), "futex word must be a plain int");
+
+inline void futexWait(std::atomic<int>& word, int expected) {
+    syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+inline void futexWake(std::atomic<int>& word, int count) {
+    syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+// Per-core idle parker. The owner calls prepare(), looks for work once more,
+// then either cancel()s or wait()s. Producers publish work first and then try
+// unparkIfParked(), so either the producer sees PARKED or the owner's recheck
+// sees the work - a wakeup cannot be lost.
+class Parker {
+private:
+    static constexpr int EMPTY = 0;
+    static constexpr int PARKED = -1;
+    static constexpr int NOTIFIED = 1;
+    
+    std::atomic<int> state{EMPTY};
+
+public:
+    // Owner only
+    void prepare() {
+        state.exchange(PARKED);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    
+    void cancel() {
+        state.store(EMPTY, std::memory_order_relaxed);
+    }
+    
+    void wait() {
+        while (state.load(std::memory_order_acquire) == PARKED) {
+            futexWait(state, PARKED);
+        }
+        state.store(EMPTY, std::memory_order_relaxed);
+    }
+    
+    // Any thread. Claims the wakeup with a CAS so concurrent producers wake
+    // different cores rather than all picking the same one
+    bool unparkIfParked() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int expected = PARKED;
+        if (state.compare_exchange_strong(expected, NOTIFIED)) {
+            futexWake(state, 1);
+            return true;
+        }
+        return false;
+    }
+    
+    void unpark() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (state.exchange(NOTIFIED) == PARKED) {
+            futexWake(state, 1);
+        }
+    }
+};
+
+// Counts outstanding tasks; wait() blocks until the count drops to zero
+class CompletionLatch {
+private:
+    std::atomic<int> count{0};
+
+public:
+    void add() {
+        count.fetch_add(1);
+    }
+    
+    // Returns true for the call that brought the count to zero
+    bool done() {
+        if (count.fetch_sub(1) == 1) {
+            futexWake(count, INT_MAX);
+            return true;
+        }
+        return false;
+    }
+    
+    int load() const {
+        return count.load();
+    }
+    
+    void wait() {
+        int current;
+        while ((current = count.load(std::memory_order_acquire)) != 0) {
+            futexWait(count, current);
+        }
+    }
+};
+
+// Fixed-size log-linear histogram of latencies in ns: exact below 8ns, then
+// 8 buckets per power of two, so a percentile read back from it is within
+// 1/8 of the true value. Memory stays constant however many tasks run.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKETS = 8;
+    static constexpr int BUCKETS = 64 * SUB_BUCKETS;
+    
+    void record(int64_t ns) {
+        ns = std::max<int64_t>(ns, 0);
+        counts[bucketOf(ns)]++;
+        samples++;
+        total_ns += ns;
+        max_ns = std::max(max_ns, ns);
+    }
+    
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < BUCKETS; i++) counts[i] += other.counts[i];
+        samples += other.samples;
+        total_ns += other.total_ns;
+        max_ns = std::max(max_ns, other.max_ns);
+    }
+    
+    int64_t count() const { return samples; }
+    int64_t max() const { return max_ns; }
+    int64_t mean() const { return samples > 0 ? total_ns / samples : 0; }
+    
+    // Upper edge of the bucket holding the p-th percentile (capped at the max)
+    int64_t percentile(double p) const {
+        int64_t rank = static_cast<int64_t>(std::ceil(p / 100.0 * samples));
+        int64_t seen = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            seen += counts[i];
+            if (seen >= std::max<int64_t>(rank, 1)) return std::min(upperEdge(i), max_ns);
+        }
+        return max_ns;
+    }
+
+private:
+    static int bucketOf(int64_t ns) {
+        if (ns < SUB_BUCKETS) return static_cast<int>(ns);
+        int msb = 63 - __builtin_clzll(static_cast<unsigned long long>(ns));
+        return (msb - 2) * SUB_BUCKETS + static_cast<int>((ns >> (msb - 3)) & (SUB_BUCKETS - 1));
+    }
+    
+    static int64_t upperEdge(int bucket) {
+        if (bucket < SUB_BUCKETS) return bucket;
+        int shift = bucket / SUB_BUCKETS - 1;
+        return ((SUB_BUCKETS + bucket % SUB_BUCKETS + int64_t(1)) << shift) - 1;
+    }
+    
+    int64_t counts[BUCKETS] = {};
+    int64_t samples = 0;
+    int64_t total_ns = 0;
+    int64_t max_ns = 0;
 };
 
 class CPUCore {
+private:
+    struct TaskNode {
+        Task task;
+        TaskNode* next;
+    };
+    
+    // Tasks submitted by other threads land in a lock-free inbox (a Treiber stack)
+    // and the owner moves them into its deque, since only the owner may push there
+    std::atomic<TaskNode*> inbox{nullptr};
+    WorkStealingDeque<TaskNode*> local_queue;
+    
+    void pushInbox(TaskNode* first, TaskNode* last) {
+        TaskNode* head = inbox.load(std::memory_order_relaxed);
+        do {
+            last->next = head;
+        } while (!inbox.compare_exchange_weak(head, first, std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+    
+    static Task release(TaskNode* node) {
+        Task task = node->task;
+        delete node;
+        return task;
+    }
+
 public:
     int core_id;
-    std::queue<Task> local_queue;
-    std::mutex queue_mutex;
     std::atomic<bool> is_busy{false};
-    std::atomic<int> load{0};
+    std::atomic<int> load{0}; // Queued tasks (inbox + deque), maintained without locks
+    Parker parker;
+    LatencyHistogram dispatch_latency; // Written only by the owner thread
     
     CPUCore(int id) : core_id(id) {}
     
-    // Delete copy constructor and assignment operator due to mutex
+    ~CPUCore() {
+        TaskNode* node = inbox.exchange(nullptr);
+        while (node) {
+            delete std::exchange(node, node->next);
+        }
+        while (local_queue.pop(node)) {
+            delete node;
+        }
+    }
+    
+    // Delete copy constructor and assignment operator due to atomics
     CPUCore(const CPUCore&) = delete;
     CPUCore& operator=(const CPUCore&) = delete;
     
+    // Any thread
     void addTask(const Task& task) {
-        std::lock_guard<std::mutex> lock(queue_mutex);
-        local_queue.push(task);
+        TaskNode* node = new TaskNode{task, nullptr};
         load++;
+        pushInbox(node, node);
     }
     
+    // Any thread: hands over a whole batch with a single CAS on the inbox
+    void addTasks(const std::vector<Task>& tasks) {
+        if (tasks.empty()) return;
+        TaskNode* first = nullptr;
+        TaskNode* last = nullptr;
+        for (const auto& task : tasks) {
+            // Prepend, so the batch keeps the inbox's newest-first order
+            first = new TaskNode{task, first};
+            if (!last) last = first;
+        }
+        load += static_cast<int>(tasks.size());
+        pushInbox(first, last);
+    }
+    
+    // Owner thread only: drain the inbox, then pop from the bottom of the deque
     bool getTask(Task& task) {
-        std::lock_guard<std::mutex> lock(queue_mutex);
-        if (!local_queue.empty()) {
-            task = local_queue.front();
-            local_queue.pop();
+        TaskNode* node = inbox.exchange(nullptr, std::memory_order_acquire);
+        // The inbox is newest-first; pushing in that order leaves the oldest at the bottom
+        while (node) {
+            local_queue.push(std::exchange(node, node->next));
+        }
+        
+        if (local_queue.pop(node)) {
             load--;
+            task = release(node);
             return true;
         }
         return false;
     }
     
-    int getQueueSize() {
-        std::lock_guard<std::mutex> lock(queue_mutex);
-        return static_cast<int>(local_queue.size());
+    // Any thread: steal the oldest task in the deque, or failing that take the
+    // oldest one still waiting in the inbox
+    bool stealTask(Task& task) {
+        TaskNode* node;
+        if (local_queue.steal(node)) {
+            load--;
+            task = release(node);
+            return true;
+        }
+        
+        node = inbox.exchange(nullptr, std::memory_order_acquire);
+        if (!node) return false;
+        TaskNode* oldest = node;
+        TaskNode* before_oldest = nullptr;
+        while (oldest->next) {
+            before_oldest = oldest;
+            oldest = oldest->next;
+        }
+        if (before_oldest) {
+            before_oldest->next = nullptr;
+            pushInbox(node, before_oldest);
+            // The owner may have found the inbox empty while we held it and parked
+            parker.unparkIfParked();
+        }
+        load--;
+        task = release(oldest);
+        return true;
+    }
+    
+    int getQueueSize() const {
+        return load.load(std::memory_order_relaxed);
+    }
+    
+    bool isEmpty() const {
+        return getQueueSize() == 0;
+    }
+};
+
+// NUMA topology: which CPUs belong to which node and what it costs a CPU on
+// one node to reach memory on another. Read from sysfs when the machine exposes
+// more than one node, simulated otherwise. Nodes are numbered by their position
+// in numa_nodes, which is also what Task::home_node refers to.
+class NUMAScheduler {
+private:
+    struct NUMANode {
+        int node_id;
+        std::vector<int> cpu_cores;
+        std::vector<int> memory_latency; // Access latency to each node's memory in nanoseconds
+        
+        NUMANode(int id, std::vector<int> cores, std::vector<int> latency) 
+            : node_id(id), cpu_cores(std::move(cores)), memory_latency(std::move(latency)) {}
+    };
+    
+    std::vector<NUMANode> numa_nodes;
+    bool from_sysfs = false;
+    
+    explicit NUMAScheduler(std::vector<NUMANode> nodes) : numa_nodes(std::move(nodes)) {}
+    
+public:
+    // Parses a kernel cpulist such as "0-3,8-11"
+    static std::vector<int> parseCpuList(const std::string& list) {
+        std::vector<int> cpus;
+        std::stringstream ss(list);
+        std::string range;
+        while (std::getline(ss, range, ',')) {
+            if (range.empty() || !std::isdigit(static_cast<unsigned char>(range[0]))) continue;
+            size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; cpu++) {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+    
+    // Simulate 2 NUMA nodes with the CPUs split between them
+    static NUMAScheduler simulated(int num_cpus) {
+        NUMAScheduler numa(std::vector<NUMANode>{});
+        int half = std::max(num_cpus / 2, 1);
+        std::vector<int> first, second;
+        for (int cpu = 0; cpu < num_cpus; cpu++) {
+            (cpu < half ? first : second).push_back(cpu);
+        }
+        numa.numa_nodes.emplace_back(0, first, std::vector<int>{100, 300}); // Local access
+        if (!second.empty()) {
+            numa.numa_nodes.emplace_back(1, second, std::vector<int>{300, 100}); // Remote access
+        }
+        return numa;
+    }
+    
+    // Reads nodeN/cpulist and nodeN/distance. SLIT distances are relative (10 =
+    // local), so they are scaled by 10 to land near real nanosecond figures.
+    // Returns false, leaving this topology untouched, if the directory is missing.
+    bool loadFromSysfs(const std::string& root = "/sys/devices/system/node") {
+        std::vector<NUMANode> nodes;
+        for (int id = 0; id < 1024; id++) {
+            std::string dir = root + "/node" + std::to_string(id);
+            std::ifstream cpulist(dir + "/cpulist");
+            if (!cpulist) continue;
+            std::string list;
+            std::getline(cpulist, list);
+            
+            std::ifstream distance(dir + "/distance");
+            std::vector<int> latency;
+            int d;
+            while (distance >> d) {
+                latency.push_back(d * 10);
+            }
+            nodes.emplace_back(id, parseCpuList(list), std::move(latency));
+        }
+        if (nodes.empty()) return false;
+        
+        for (auto& node : nodes) {
+            // Fall back to local-only latency if the distance row is missing or short
+            node.memory_latency.resize(nodes.size(), 100);
+        }
+        numa_nodes = std::move(nodes);
+        from_sysfs = true;
+        return true;
+    }
+    
+    // The machine's topology if it has more than one node, else a simulated one
+    // over num_cpus CPUs so placement still has something to work with
+    static NUMAScheduler detect(int num_cpus) {
+        NUMAScheduler numa(std::vector<NUMANode>{});
+        if (numa.loadFromSysfs() && numa.nodeCount() > 1) {
+            return numa;
+        }
+        return simulated(num_cpus);
+    }
+    
+    NUMAScheduler() : NUMAScheduler(simulated(4)) {}
+    
+    int nodeCount() const {
+        return static_cast<int>(numa_nodes.size());
+    }
+    
+    bool isFromSysfs() const {
+        return from_sysfs;
+    }
+    
+    // Latency for a CPU on cpu_node to reach memory on memory_node
+    int memoryLatency(int cpu_node, int memory_node) const {
+        return numa_nodes[cpu_node].memory_latency[memory_node];
+    }
+    
+    int selectOptimalCore(int preferred_node = -1) {
+        if (preferred_node >= 0 && preferred_node < static_cast<int>(numa_nodes.size())) {
+            // Return first available core from preferred NUMA node
+            const auto& node = numa_nodes[preferred_node];
+            if (!node.cpu_cores.empty()) {
+                return node.cpu_cores[0];
+            }
+        }
+        
+        // Find node with lowest local memory latency that has available cores
+        int best_node = 0;
+        int min_latency = numa_nodes[0].memory_latency[0];
+        
+        for (size_t i = 1; i < numa_nodes.size(); i++) {
+            if (!numa_nodes[i].cpu_cores.empty() && numa_nodes[i].memory_latency[i] < min_latency) {
+                min_latency = numa_nodes[i].memory_latency[i];
+                best_node = static_cast<int>(i);
+            }
+        }
+        
+        return numa_nodes[best_node].cpu_cores[0];
+    }
+    
+    // NUMA node owning the given CPU, or -1 if the CPU is not in the topology
+    int nodeOfCpu(int cpu) const {
+        for (size_t i = 0; i < numa_nodes.size(); i++) {
+            for (int core : numa_nodes[i].cpu_cores) {
+                if (core == cpu) return static_cast<int>(i);
+            }
+        }
+        return -1;
     }
     
-    bool isEmpty() {
-        std::lock_guard<std::mutex> lock(queue_mutex);
-        return local_queue.empty();
+    void displayNUMATopology() const {
+        std::cout << "\n=== NUMA TOPOLOGY (" << (from_sysfs ? "sysfs" : "simulated") << ") ===\n";
+        for (const auto& node : numa_nodes) {
+            std::cout << "NUMA Node " << node.node_id 
+                      << ": CPUs [";
+            for (size_t i = 0; i < node.cpu_cores.size(); i++) {
+                std::cout << node.cpu_cores[i];
+                if (i < node.cpu_cores.size() - 1) std::cout << ", ";
+            }
+            std::cout << "], Memory Latency: [";
+            for (size_t i = 0; i < node.memory_latency.size(); i++) {
+                std::cout << node.memory_latency[i] << "ns";
+                if (i < node.memory_latency.size() - 1) std::cout << ", ";
+            }
+            std::cout << "]\n";
+        }
     }
 };
 
@@ -76,89 +641,474 @@ private:
     std::vector<std::unique_ptr<CPUCore>> cores;
     std::queue<Task> global_queue;
     std::mutex global_mutex;
-    std::condition_variable cv;
     std::atomic<bool> running{true};
-    std::atomic<int> active_tasks{0};
+    CompletionLatch active_tasks;
     std::atomic<int> completed_tasks{0};
+    std::atomic<unsigned> next_wake{0};
     int num_cores;
+    bool verbose;
+    
+    // Placement
+    NUMAScheduler topology;
+    std::vector<int> core_node; // NUMA node of each core, as an index into topology
+    std::vector<int> pinned_cpus; // Physical CPU for each core's worker thread; empty = unpinned
+    int queue_weight_ns = 50;   // Cost of one queued task, traded against memory latency
+    int cross_node_imbalance = 4;
+    
+    struct NodeCounters {
+        std::atomic<long long> local{0};  // Tasks run on this node whose memory is here
+        std::atomic<long long> remote{0}; // Tasks run on this node whose memory is elsewhere
+    };
+    std::unique_ptr<NodeCounters[]> node_counters;
+    
+    // Real-time jobs wait in one global heap ahead of all best-effort work, so
+    // every core dispatches the globally most urgent job (global EDF or RM).
+    // Jobs are not preempted once started.
+    RealTimePolicy rt_policy = RealTimePolicy::EDF;
+    std::priority_queue<Task, std::vector<Task>, RealTimeOrder> rt_queue;
+    std::mutex rt_mutex;
+    std::atomic<int> rt_pending{0};          // rt_queue.size(), readable without the lock
+    std::vector<Task> rt_admitted;           // Task set that passed admissionTest
+    std::atomic<long long> rt_jobs{0};
+    std::atomic<long long> rt_misses{0};
+    std::atomic<long long> rt_max_lateness_us{LLONG_MIN};
+    std::atomic<long long> rt_histogram[9];  // Indexed by latenessBucket
     
     // Load balancing parameters
     static constexpr int LOAD_BALANCE_THRESHOLD = 2;
     static constexpr int MIGRATION_COST = 5; // milliseconds
     
 public:
-    MultiProcessorScheduler(int cores_count) : num_cores(cores_count) {
+    struct NodeExecutionStats {
+        int node;
+        long long local;
+        long long remote;
+    };
+    
+    // Upper edges of the lateness histogram buckets in ms; the first bucket
+    // holds jobs that met their deadline, the last everything above 100ms
+    static constexpr int LATENESS_BUCKETS_MS[8] = {0, 1, 2, 5, 10, 20, 50, 100};
+    
+    struct RealTimeStats {
+        long long jobs = 0;
+        long long misses = 0;
+        long long max_lateness_us = 0; // Negative when every job finished early
+        std::vector<long long> lateness_histogram = std::vector<long long>(9, 0);
+        
+        double missRate() const {
+            return jobs > 0 ? static_cast<double>(misses) / jobs : 0.0;
+        }
+    };
+    
+    struct AdmissionResult {
+        bool admitted;
+        double utilization; // Sum of the tasks' densities
+        double bound;       // Largest total the test accepts on this many cores
+    };
+    
+    MultiProcessorScheduler(int cores_count, bool verbose_output = true)
+        : num_cores(cores_count), verbose(verbose_output) {
         cores.reserve(cores_count);
         for (int i = 0; i < cores_count; i++) {
             cores.push_back(std::make_unique<CPUCore>(i));
         }
+        setTopology(NUMAScheduler::simulated(cores_count));
+        for (auto& bucket : rt_histogram) bucket = 0;
     }
     
-    void addTask(const Task& task) {
-        if (task.preferred_cpu >= 0 && task.preferred_cpu < num_cores) {
-            // Processor affinity - try preferred CPU first
-            cores[task.preferred_cpu]->addTask(task);
+    // Adopt a NUMA layout for placement, stealing and balancing. Cores the
+    // topology does not mention are treated as node 0. Call before starting cores.
+    void setTopology(const NUMAScheduler& numa) {
+        topology = numa;
+        core_node.assign(num_cores, 0);
+        for (int i = 0; i < num_cores; i++) {
+            core_node[i] = std::max(numa.nodeOfCpu(physicalCpu(i)), 0);
+        }
+        node_counters.reset(new NodeCounters[topology.nodeCount()]);
+    }
+    
+    // Bind core i's worker thread to cpus[i % cpus.size()] when it starts, so a
+    // task's preferred_cpu really keeps it on one CPU's caches. An empty list
+    // turns pinning off. Call before starting cores.
+    void pinToCpus(const std::vector<int>& cpus) {
+        pinned_cpus = cpus;
+        setTopology(NUMAScheduler(topology));
+    }
+    
+    // The CPU the topology should use for a core: its pinned CPU if any,
+    // otherwise the core index stands in for one
+    int physicalCpu(int core_id) const {
+        return pinned_cpus.empty() ? core_id : pinned_cpus[core_id % pinned_cpus.size()];
+    }
+    
+    // CPUs this process may run on, in ascending order
+    static std::vector<int> allowedCpus() {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        std::vector<int> cpus;
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+    
+    // queue_weight_ns: how many nanoseconds of memory latency one queued task is worth
+    // cross_node_imbalance: queue length a remote core must exceed before it is stolen from
+    void setPlacementWeights(int queue_weight, int imbalance) {
+        queue_weight_ns = queue_weight;
+        cross_node_imbalance = imbalance;
+    }
+    
+    // Dispatch order for real-time jobs. Call before releasing any.
+    void setRealTimePolicy(RealTimePolicy policy) {
+        std::lock_guard<std::mutex> lock(rt_mutex);
+        rt_policy = policy;
+        rt_queue = std::priority_queue<Task, std::vector<Task>, RealTimeOrder>(RealTimeOrder{policy});
+    }
+    
+    // Sufficient utilization-bound schedulability tests for global scheduling
+    // of preemptive sporadic tasks on `cores` identical CPUs (umax = largest
+    // single density):
+    //   EDF, 1 core:  U <= 1                      (Liu & Layland)
+    //   EDF, m cores: U <= m - (m - 1) * umax      (Goossens, Funk & Baruah)
+    //   RM, 1 core:   U <= n * (2^(1/n) - 1)       (Liu & Layland)
+    //   RM, m cores:  U <= m / 2 * (1 - umax) + umax (Bertogna, Cirinei & Lipari)
+    // Jobs here run to completion once started, so a long job can still block a
+    // more urgent one; passing the test bounds the load, it does not promise zero misses.
+    static AdmissionResult admissionTest(const std::vector<Task>& tasks, int cores, RealTimePolicy policy) {
+        double total = 0.0;
+        double umax = 0.0;
+        for (const Task& task : tasks) {
+            total += task.utilization();
+            umax = std::max(umax, task.utilization());
+        }
+        int n = static_cast<int>(tasks.size());
+        double m = std::max(cores, 1);
+        double bound;
+        if (policy == RealTimePolicy::EDF) {
+            bound = m == 1 ? 1.0 : m - (m - 1) * umax;
+        } else if (m == 1) {
+            bound = n > 0 ? n * (std::pow(2.0, 1.0 / n) - 1) : 1.0;
         } else {
-            // Global queue for load balancing
-            std::lock_guard<std::mutex> lock(global_mutex);
-            global_queue.push(task);
+            bound = m / 2 * (1 - umax) + umax;
         }
-        active_tasks++;
-        cv.notify_all();
+        return {umax <= 1.0 && total <= bound + 1e-9, total, bound};
     }
     
-    void cpuScheduler(int core_id) {
-        std::cout << "CPU Core " << core_id << " scheduler started\n";
+    // Adds a periodic or sporadic task to the admitted set if the set still
+    // passes admissionTest on this scheduler's cores
+    bool admitRealTimeTask(const Task& task) {
+        std::lock_guard<std::mutex> lock(rt_mutex);
+        std::vector<Task> candidate = rt_admitted;
+        candidate.push_back(task);
+        if (!task.isRealTime() || !admissionTest(candidate, num_cores, rt_policy).admitted) {
+            return false;
+        }
+        rt_admitted.push_back(task);
+        return true;
+    }
+    
+    // Releases jobs of every admitted task from the calling thread until the
+    // horizon has passed: periodic tasks exactly every period, sporadic ones
+    // after a random extra gap of up to half a period
+    void releaseRealTimeJobs(std::chrono::milliseconds horizon) {
+        std::vector<Task> tasks;
+        {
+            std::lock_guard<std::mutex> lock(rt_mutex);
+            tasks = rt_admitted;
+        }
+        if (tasks.empty()) return;
         
-        while (running.load() || active_tasks.load() > 0) {
-            Task current_task(0, 0);
-            bool has_task = false;
+        std::mt19937 gen(std::random_device{}());
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::chrono::steady_clock::time_point> next_release(tasks.size(), start);
+        while (true) {
+            size_t due = std::min_element(next_release.begin(), next_release.end()) - next_release.begin();
+            if (next_release[due] - start >= horizon) break;
+            std::this_thread::sleep_until(next_release[due]);
             
-            // Try to get task from local queue first (processor affinity)
-            if (cores[core_id]->getTask(current_task)) {
-                has_task = true;
+            Task job = tasks[due];
+            job.arrival_time = next_release[due];
+            addTask(job);
+            
+            int gap = job.period_ms;
+            if (job.sporadic) gap += std::uniform_int_distribution<>(0, job.period_ms / 2)(gen);
+            next_release[due] += std::chrono::milliseconds(gap);
+        }
+    }
+    
+    // Offline prediction: replays the task set on `cores` simulated CPUs in
+    // 1ms steps with the same non-preemptive global dispatching, every job
+    // taking its full WCET and sporadic tasks arriving as often as allowed
+    // (the worst case). Jobs released before horizon_ms run to completion.
+    static RealTimeStats simulateRealTime(const std::vector<Task>& tasks, int cores, RealTimePolicy policy,
+                                          int horizon_ms) {
+        using ms = std::chrono::milliseconds;
+        const auto epoch = std::chrono::steady_clock::time_point();
+        RealTimeStats stats;
+        std::priority_queue<Task, std::vector<Task>, RealTimeOrder> ready{RealTimeOrder{policy}};
+        std::vector<std::pair<long long, long long>> busy_until(std::max(cores, 1), {0, LLONG_MIN}); // finish, deadline (LLONG_MIN: no job)
+        std::vector<long long> next_release(tasks.size(), 0);
+        
+        auto record = [&stats](long long lateness_ms) {
+            stats.jobs++;
+            if (lateness_ms > 0) stats.misses++;
+            stats.max_lateness_us = std::max(stats.max_lateness_us, lateness_ms * 1000);
+            stats.lateness_histogram[latenessBucket(lateness_ms * 1000)]++;
+        };
+        
+        stats.max_lateness_us = LLONG_MIN;
+        for (long long now = 0;; now++) {
+            for (auto& core : busy_until) {
+                if (core.first == now && core.second != LLONG_MIN) {
+                    record(core.first - core.second);
+                    core.second = LLONG_MIN;
+                }
+            }
+            for (size_t i = 0; i < tasks.size(); i++) {
+                if (now < horizon_ms && next_release[i] == now) {
+                    Task job = tasks[i];
+                    job.absolute_deadline = epoch + ms(now + job.deadline_ms);
+                    ready.push(job);
+                    next_release[i] += job.period_ms;
+                }
+            }
+            bool idle = true;
+            for (auto& core : busy_until) {
+                if (core.first <= now && !ready.empty()) {
+                    const Task& job = ready.top();
+                    core = {now + std::max(job.wcet_ms, 1),
+                            std::chrono::duration_cast<ms>(job.absolute_deadline - epoch).count()};
+                    ready.pop();
+                }
+                if (core.first > now) idle = false;
             }
-            // Try global queue
-            else {
+            if (now >= horizon_ms && idle && ready.empty()) break;
+        }
+        if (stats.jobs == 0) stats.max_lateness_us = 0;
+        return stats;
+    }
+    
+    RealTimeStats realTimeStats() const {
+        RealTimeStats stats;
+        stats.jobs = rt_jobs.load();
+        stats.misses = rt_misses.load();
+        stats.max_lateness_us = stats.jobs > 0 ? rt_max_lateness_us.load() : 0;
+        for (int i = 0; i < 9; i++) {
+            stats.lateness_histogram[i] = rt_histogram[i].load();
+        }
+        return stats;
+    }
+    
+    static int latenessBucket(long long lateness_us) {
+        int bucket = 0;
+        while (bucket < 8 && lateness_us > LATENESS_BUCKETS_MS[bucket] * 1000LL) bucket++;
+        return bucket;
+    }
+    
+    static void displayRealTimeStats(const RealTimeStats& stats) {
+        std::printf("Jobs: %lld, Deadline Misses: %lld (%.2f%%), Max Lateness: %.1fms\n", stats.jobs,
+                    stats.misses, stats.missRate() * 100, stats.max_lateness_us / 1000.0);
+        std::printf("Lateness histogram:\n");
+        for (int i = 0; i < 9; i++) {
+            std::string label = i == 0 ? "on time"
+                              : i == 8 ? ">" + std::to_string(LATENESS_BUCKETS_MS[7]) + "ms"
+                              : std::to_string(LATENESS_BUCKETS_MS[i - 1]) + "-"
+                                + std::to_string(LATENESS_BUCKETS_MS[i]) + "ms";
+            std::printf("  %-10s %8lld\n", label.c_str(), stats.lateness_histogram[i]);
+        }
+    }
+    
+    const NUMAScheduler& numaTopology() const {
+        return topology;
+    }
+    
+    // Core with the lowest queue-length-plus-memory-latency cost for a task
+    // whose memory lives on home_node
+    int placeTask(int home_node) const {
+        int best_core = 0;
+        long long best_cost = LLONG_MAX;
+        for (int i = 0; i < num_cores; i++) {
+            long long queued = cores[i]->getQueueSize() + (cores[i]->is_busy.load() ? 1 : 0);
+            long long cost = queued * queue_weight_ns + topology.memoryLatency(core_node[i], home_node);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_core = i;
+            }
+        }
+        return best_core;
+    }
+    
+    std::vector<NodeExecutionStats> nodeExecutionStats() const {
+        std::vector<NodeExecutionStats> stats;
+        for (int node = 0; node < topology.nodeCount(); node++) {
+            stats.push_back({node, node_counters[node].local.load(), node_counters[node].remote.load()});
+        }
+        return stats;
+    }
+    
+    void addTask(const Task& task) {
+        // Count the task before it becomes visible so a fast core cannot
+        // complete it while the latch still reads zero
+        active_tasks.add();
+        
+        if (task.isRealTime()) {
+            // One job of a real-time task; its deadline counts from its release
+            Task job = task;
+            job.absolute_deadline = job.arrival_time + std::chrono::milliseconds(job.deadline_ms);
+            {
+                std::lock_guard<std::mutex> lock(rt_mutex);
+                rt_queue.push(job);
+                rt_pending++;
+            }
+            wakeIdleCore();
+            return;
+        }
+        
+        bool has_home = task.home_node >= 0 && task.home_node < topology.nodeCount();
+        if ((task.preferred_cpu >= 0 && task.preferred_cpu < num_cores) || has_home) {
+            // Processor affinity - try preferred CPU first, otherwise place near the task's memory
+            int target = task.preferred_cpu >= 0 && task.preferred_cpu < num_cores
+                       ? task.preferred_cpu : placeTask(task.home_node);
+            CPUCore& core = *cores[target];
+            core.addTask(task);
+            // If the chosen core is busy and its backlog is stealable, let an idle core help
+            if (!core.parker.unparkIfParked() && core.getQueueSize() > LOAD_BALANCE_THRESHOLD) {
+                wakeIdleCore(target);
+            }
+        } else {
+            // Global queue for load balancing
+            {
                 std::lock_guard<std::mutex> lock(global_mutex);
-                if (!global_queue.empty()) {
-                    current_task = global_queue.front();
-                    global_queue.pop();
-                    has_task = true;
+                global_queue.push(task);
+            }
+            wakeIdleCore();
+        }
+    }
+    
+    // Wakes exactly one parked core (other than skip_core), starting from a rotating
+    // position so wakeups spread across cores. Cores on skip_core's node are tried
+    // first, since they can steal from it without crossing nodes. Returns false if
+    // none was parked.
+    bool wakeIdleCore(int skip_core = -1) {
+        int start = static_cast<int>(next_wake.fetch_add(1, std::memory_order_relaxed) % num_cores);
+        for (bool same_node : {true, false}) {
+            for (int offset = 0; offset < num_cores; offset++) {
+                int i = (start + offset) % num_cores;
+                if (i == skip_core) continue;
+                if (skip_core >= 0 && (core_node[i] == core_node[skip_core]) != same_node) continue;
+                if (cores[i]->parker.unparkIfParked()) {
+                    return true;
                 }
             }
-            
-            // Work stealing - try to steal from other cores
-            if (!has_task) {
-                has_task = workStealing(core_id, current_task);
+            if (skip_core < 0) break;
+        }
+        return false;
+    }
+    
+    bool findTask(int core_id, Task& task) {
+        // Real-time jobs go before any best-effort work
+        if (rt_pending.load() > 0) {
+            std::lock_guard<std::mutex> lock(rt_mutex);
+            if (!rt_queue.empty()) {
+                task = rt_queue.top();
+                rt_queue.pop();
+                rt_pending--;
+                return true;
+            }
+        }
+        
+        // Try to get task from local queue first (processor affinity)
+        if (cores[core_id]->getTask(task)) {
+            return true;
+        }
+        
+        // Try global queue
+        {
+            std::lock_guard<std::mutex> lock(global_mutex);
+            if (!global_queue.empty()) {
+                task = global_queue.front();
+                global_queue.pop();
+                return true;
+            }
+        }
+        
+        // Work stealing - try to steal from other cores
+        return workStealing(core_id, task);
+    }
+    
+    void cpuScheduler(int core_id) {
+        if (verbose) std::cout << "CPU Core " << core_id << " scheduler started\n";
+        CPUCore& core = *cores[core_id];
+        
+        if (!pinned_cpus.empty()) {
+            int cpu = physicalCpu(core_id);
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            if (rc != 0) {
+                // Keep running unpinned rather than losing the core
+                std::cerr << "CPU Core " << core_id << ": cannot pin to CPU " << cpu
+                          << ": " << std::strerror(rc) << "\n";
+            } else if (verbose) {
+                std::cout << "CPU Core " << core_id << " pinned to CPU " << cpu << "\n";
+            }
+        }
+        
+        while (true) {
+            Task current_task(0, 0);
+            if (findTask(core_id, current_task)) {
+                executeTask(core_id, current_task);
+                continue;
             }
             
-            if (has_task) {
+            // Nothing to run: announce that we are parking, then look once more
+            // so a task published concurrently is not missed
+            core.parker.prepare();
+            bool shutting_down = !running.load() && active_tasks.load() == 0;
+            if (shutting_down || findTask(core_id, current_task)) {
+                core.parker.cancel();
+                if (shutting_down) break;
                 executeTask(core_id, current_task);
-            } else {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
             }
+            core.parker.wait();
         }
         
-        std::cout << "CPU Core " << core_id << " scheduler stopped\n";
+        if (verbose) std::cout << "CPU Core " << core_id << " scheduler stopped\n";
     }
     
     bool workStealing(int core_id, Task& stolen_task) {
-        // Find the most loaded core
-        int max_load = 0;
-        int victim_core = -1;
+        // Find the most loaded core, preferring our own node. A core on another
+        // node is only a victim once its backlog exceeds cross_node_imbalance,
+        // since the task would then run away from its memory.
+        int own_load = cores[core_id]->getQueueSize();
+        int local_victim = -1;
+        int remote_victim = -1;
         
         for (int i = 0; i < num_cores; i++) {
-            if (i != core_id && cores[i]->getQueueSize() > max_load + LOAD_BALANCE_THRESHOLD) {
-                max_load = cores[i]->getQueueSize();
-                victim_core = i;
+            if (i == core_id) continue;
+            int queue_size = cores[i]->getQueueSize();
+            if (core_node[i] == core_node[core_id]) {
+                if (queue_size > LOAD_BALANCE_THRESHOLD &&
+                    (local_victim == -1 || queue_size > cores[local_victim]->getQueueSize())) {
+                    local_victim = i;
+                }
+            } else if (queue_size - own_load > cross_node_imbalance &&
+                       (remote_victim == -1 || queue_size > cores[remote_victim]->getQueueSize())) {
+                remote_victim = i;
             }
         }
         
-        if (victim_core != -1 && cores[victim_core]->getTask(stolen_task)) {
-            std::cout << "Core " << core_id << " stole task " << stolen_task.task_id 
-                      << " from Core " << victim_core << "\n";
-            return true;
+        for (int victim_core : {local_victim, remote_victim}) {
+            if (victim_core != -1 && cores[victim_core]->stealTask(stolen_task)) {
+                if (verbose) std::cout << "Core " << core_id << " stole task " << stolen_task.task_id 
+                                       << " from Core " << victim_core << "\n";
+                return true;
+            }
         }
         
         return false;
@@ -167,65 +1117,164 @@ public:
     void executeTask(int core_id, Task& task) {
         cores[core_id]->is_busy = true;
         task.start_time = std::chrono::steady_clock::now();
+        cores[core_id]->dispatch_latency.record(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(task.start_time - task.arrival_time).count());
         
-        std::cout << "Core " << core_id << " executing Task " << task.task_id 
-                  << " (Burst: " << task.burst_time << "ms)\n";
+        if (verbose) {
+            std::cout << "Core " << core_id << " executing Task " << task.task_id 
+                      << " (Burst: " << task.burst_time << "ms)\n";
+        }
         
         // Simulate task execution
-        std::this_thread::sleep_for(std::chrono::milliseconds(task.burst_time));
+        if (task.body) {
+            task.body();
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(task.burst_time));
+        }
         
         task.completion_time = std::chrono::steady_clock::now();
         
         auto turnaround_time = std::chrono::duration_cast<std::chrono::milliseconds>
             (task.completion_time - task.arrival_time);
         
-        std::cout << "Core " << core_id << " completed Task " << task.task_id 
-                  << " (Turnaround: " << turnaround_time.count() << "ms)\n";
+        if (verbose) {
+            std::cout << "Core " << core_id << " completed Task " << task.task_id 
+                      << " (Turnaround: " << turnaround_time.count() << "ms)\n";
+        }
         
         cores[core_id]->is_busy = false;
-        active_tasks--;
+        if (task.isRealTime()) {
+            recordLateness(std::chrono::duration_cast<std::chrono::microseconds>
+                (task.completion_time - task.absolute_deadline).count());
+        }
+        if (task.home_node >= 0 && task.home_node < topology.nodeCount()) {
+            NodeCounters& counters = node_counters[core_node[core_id]];
+            (core_node[core_id] == task.home_node ? counters.local : counters.remote)++;
+        }
         completed_tasks++;
+        // Parked cores stay asleep through shutdown until the last task finishes
+        if (active_tasks.done() && !running.load()) {
+            wakeAllCores();
+        }
+    }
+    
+    void recordLateness(long long lateness_us) {
+        rt_jobs++;
+        if (lateness_us > 0) rt_misses++;
+        rt_histogram[latenessBucket(lateness_us)]++;
+        long long seen = rt_max_lateness_us.load();
+        while (lateness_us > seen && !rt_max_lateness_us.compare_exchange_weak(seen, lateness_us)) {}
+    }
+    
+    void wakeAllCores() {
+        for (auto& core : cores) {
+            core->parker.unpark();
+        }
     }
     
     void loadBalancer() {
         while (running.load()) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            
-            // Check load imbalance
-            int min_load = INT_MAX;
-            int max_load = 0;
-            int min_core = -1;
-            int max_core = -1;
-            
-            for (int i = 0; i < num_cores; i++) {
-                int load = cores[i]->getQueueSize();
-                if (load < min_load) {
-                    min_load = load;
-                    min_core = i;
-                }
-                if (load > max_load) {
-                    max_load = load;
-                    max_core = i;
-                }
-            }
-            
-            // Migrate tasks if imbalance is significant
-            if (max_load - min_load > LOAD_BALANCE_THRESHOLD && max_core != -1 && min_core != -1) {
-                Task migrated_task(0, 0);
-                if (cores[max_core]->getTask(migrated_task)) {
-                    cores[min_core]->addTask(migrated_task);
-                    std::cout << "Load Balancer: Migrated Task " << migrated_task.task_id 
-                              << " from Core " << max_core << " to Core " << min_core << "\n";
+            balanceOnce();
+        }
+    }
+    
+    // One balancing pass over a lock-free snapshot of the per-core loads. Cores
+    // are first evened out within each NUMA node, where a migration keeps the
+    // task near its cache and memory; tasks cross nodes only when the per-core
+    // averages of two nodes still differ by more than cross_node_imbalance.
+    void balanceOnce() {
+        std::vector<int> loads(num_cores);
+        for (int i = 0; i < num_cores; i++) {
+            loads[i] = cores[i]->getQueueSize();
+        }
+        int num_nodes = topology.nodeCount();
+        
+        for (int node = 0; node < num_nodes; node++) {
+            // Each pass halves the gap between the extremes, so cores-in-node passes suffice
+            for (int pass = 0; pass < num_cores; pass++) {
+                int max_core = -1;
+                int min_core = -1;
+                for (int i = 0; i < num_cores; i++) {
+                    if (core_node[i] != node) continue;
+                    if (max_core == -1 || loads[i] > loads[max_core]) max_core = i;
+                    if (min_core == -1 || loads[i] < loads[min_core]) min_core = i;
                 }
+                if (max_core == -1 || loads[max_core] - loads[min_core] <= LOAD_BALANCE_THRESHOLD) break;
+                if (migrateBatch(max_core, min_core, (loads[max_core] - loads[min_core]) / 2, loads) == 0) break;
             }
         }
+        
+        if (num_nodes < 2) return;
+        std::vector<int> node_load(num_nodes, 0);
+        std::vector<int> node_cores(num_nodes, 0);
+        for (int i = 0; i < num_cores; i++) {
+            node_load[core_node[i]] += loads[i];
+            node_cores[core_node[i]]++;
+        }
+        int heavy = -1;
+        int light = -1;
+        for (int node = 0; node < num_nodes; node++) {
+            if (node_cores[node] == 0) continue;
+            // Compare averages by cross-multiplying to stay in integers
+            if (heavy == -1 || node_load[node] * node_cores[heavy] > node_load[heavy] * node_cores[node]) heavy = node;
+            if (light == -1 || node_load[node] * node_cores[light] < node_load[light] * node_cores[node]) light = node;
+        }
+        if (heavy == light ||
+            node_load[heavy] * node_cores[light] - node_load[light] * node_cores[heavy]
+                <= cross_node_imbalance * node_cores[heavy] * node_cores[light]) {
+            return;
+        }
+        
+        int src = -1;
+        int dst = -1;
+        for (int i = 0; i < num_cores; i++) {
+            if (core_node[i] == heavy && (src == -1 || loads[i] > loads[src])) src = i;
+            if (core_node[i] == light && (dst == -1 || loads[i] < loads[dst])) dst = i;
+        }
+        // Tasks that would leave both nodes with the same average load
+        int batch = (node_load[heavy] * node_cores[light] - node_load[light] * node_cores[heavy])
+                    / (node_cores[heavy] + node_cores[light]);
+        migrateBatch(src, dst, std::min(batch, loads[src]), loads);
+    }
+    
+    // Steals up to count of the oldest tasks from src and hands them to dst in
+    // one inbox push. Returns how many actually moved (others may have run meanwhile).
+    int migrateBatch(int src, int dst, int count, std::vector<int>& loads) {
+        std::vector<Task> batch;
+        batch.reserve(count);
+        Task migrated_task(0, 0);
+        while (static_cast<int>(batch.size()) < count && cores[src]->stealTask(migrated_task)) {
+            batch.push_back(migrated_task);
+        }
+        if (batch.empty()) return 0;
+        
+        cores[dst]->addTasks(batch);
+        cores[dst]->parker.unparkIfParked();
+        int moved = static_cast<int>(batch.size());
+        loads[src] -= moved;
+        loads[dst] += moved;
+        
+        if (verbose) {
+            std::cout << "Load Balancer: Migrated " << moved << " task(s) from Core " << src
+                      << " to Core " << dst
+                      << (core_node[src] == core_node[dst] ? " (same node)" : " (cross-node)") << "\n";
+        }
+        return moved;
     }
     
     void waitForCompletion() {
-        // Wait until all tasks are completed
-        while (active_tasks.load() > 0) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        active_tasks.wait();
+    }
+    
+    // Submission-to-start latency of every task executed so far. Only safe to
+    // call while no tasks are running (e.g. after waitForCompletion or stop).
+    LatencyHistogram dispatchLatencies() const {
+        LatencyHistogram all;
+        for (const auto& core : cores) {
+            all.merge(core->dispatch_latency);
         }
+        return all;
     }
     
     void displayStats() {
@@ -236,78 +1285,356 @@ public:
         }
         std::cout << "Active Tasks: " << active_tasks.load() << "\n";
         std::cout << "Completed Tasks: " << completed_tasks.load() << "\n";
+        for (const auto& stats : nodeExecutionStats()) {
+            std::cout << "NUMA Node " << stats.node << ": Local Executions = " << stats.local
+                      << ", Remote Executions = " << stats.remote << "\n";
+        }
+        
+        LatencyHistogram latencies = dispatchLatencies();
+        if (latencies.count() > 0) {
+            std::cout << "Average Dispatch Latency: " << latencies.mean() / 1000 << "us\n";
+        }
+        if (rt_jobs.load() > 0) {
+            std::cout << "Real-Time (" << (rt_policy == RealTimePolicy::EDF ? "EDF" : "RM") << ") ";
+            displayRealTimeStats(realTimeStats());
+        }
     }
     
     void stop() {
         running = false;
-        cv.notify_all();
+        wakeAllCores();
     }
 };
 
-// NUMA-aware scheduler simulation
-class NUMAScheduler {
+// Same interface as WorkStealingDeque, one mutex around a std::deque; the
+// baseline the per-core queues used before
+template <typename T>
+class LockedDeque {
 private:
-    struct NUMANode {
-        int node_id;
-        std::vector<int> cpu_cores;
-        int memory_latency; // Access latency in nanoseconds
+    std::deque<T> items;
+    mutable std::mutex mtx;
+
+public:
+    void push(T value) {
+        std::lock_guard<std::mutex> lock(mtx);
+        items.push_back(value);
+    }
+    
+    bool pop(T& out) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (items.empty()) return false;
+        out = items.back();
+        items.pop_back();
+        return true;
+    }
+    
+    bool steal(T& out) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (items.empty()) return false;
+        out = items.front();
+        items.pop_front();
+        return true;
+    }
+};
+
+// Fork-join contention benchmark: every task of depth d > 0 spawns two tasks of
+// depth d - 1 onto its worker's own deque. The root starts on worker 0, so the
+// others only get work by stealing. Returns tasks per second.
+template <typename Deque>
+double runStealBenchmark(int threads, int depth) {
+    std::vector<std::unique_ptr<Deque>> deques;
+    for (int i = 0; i < threads; i++) {
+        deques.push_back(std::make_unique<Deque>());
+    }
+    const int64_t total = (int64_t(1) << (depth + 1)) - 1;
+    std::atomic<int64_t> done{0};
+    std::atomic<int64_t> steals{0};
+    deques[0]->push(depth);
+    
+    auto worker = [&](int id) {
+        std::mt19937 gen(id + 1);
+        std::uniform_int_distribution<> victim_dist(0, threads - 1);
+        int64_t local_done = 0;
+        int64_t local_steals = 0;
         
-        NUMANode(int id, std::vector<int> cores, int latency) 
-            : node_id(id), cpu_cores(std::move(cores)), memory_latency(latency) {}
+        while (done.load(std::memory_order_relaxed) < total) {
+            int task;
+            bool found = deques[id]->pop(task);
+            if (!found && threads > 1) {
+                int victim = victim_dist(gen);
+                if (victim != id && deques[victim]->steal(task)) {
+                    found = true;
+                    local_steals++;
+                }
+            }
+            if (!found) {
+                if (local_done > 0) {
+                    done.fetch_add(local_done, std::memory_order_relaxed);
+                    local_done = 0;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            
+            if (task > 0) {
+                deques[id]->push(task - 1);
+                deques[id]->push(task - 1);
+            }
+            // Publish in batches so the shared counter is not the bottleneck
+            if (++local_done == 256) {
+                done.fetch_add(local_done, std::memory_order_relaxed);
+                local_done = 0;
+            }
+        }
+        steals.fetch_add(local_steals, std::memory_order_relaxed);
     };
     
-    std::vector<NUMANode> numa_nodes;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back(worker, i);
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total / seconds;
+}
+
+void benchmarkWorkStealing(int depth) {
+    std::cout << "Tasks per run: " << ((int64_t(1) << (depth + 1)) - 1) << "\n\n";
+    std::cout << "Threads   Mutex deque (tasks/s)   Chase-Lev (tasks/s)   Speedup\n";
+    for (int threads : {2, 8, 32, 128}) {
+        double locked = runStealBenchmark<LockedDeque<int>>(threads, depth);
+        double lock_free = runStealBenchmark<WorkStealingDeque<int>>(threads, depth);
+        std::printf("%7d   %21.0f   %19.0f   %6.2fx\n", threads, locked, lock_free, lock_free / locked);
+    }
+}
+
+// Submits one empty task at a time to a scheduler whose cores are all parked
+// and reports how long each took to start running
+void benchmarkDispatchLatency(int num_cores, int samples) {
+    MultiProcessorScheduler scheduler(num_cores, false);
+    std::vector<std::thread> cpu_threads;
+    for (int i = 0; i < num_cores; i++) {
+        cpu_threads.emplace_back(&MultiProcessorScheduler::cpuScheduler, &scheduler, i);
+    }
     
-public:
-    NUMAScheduler() {
-        // Simulate 2 NUMA nodes
-        numa_nodes.emplace_back(0, std::vector<int>{0, 1}, 100); // Local access
-        numa_nodes.emplace_back(1, std::vector<int>{2, 3}, 300); // Remote access
+    for (int i = 0; i < samples; i++) {
+        // Give the core that ran the previous task time to park again
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        int preferred_cpu = (i % 2 == 0) ? -1 : i % num_cores;
+        scheduler.addTask(Task(i, 0, preferred_cpu));
+        scheduler.waitForCompletion();
     }
     
-    int selectOptimalCore(int preferred_node = -1) {
-        if (preferred_node >= 0 && preferred_node < static_cast<int>(numa_nodes.size())) {
-            // Return first available core from preferred NUMA node
-            const auto& node = numa_nodes[preferred_node];
-            if (!node.cpu_cores.empty()) {
-                return node.cpu_cores[0];
+    scheduler.stop();
+    for (auto& thread : cpu_threads) {
+        thread.join();
+    }
+    
+    LatencyHistogram latencies = scheduler.dispatchLatencies();
+    std::printf("%5d   %8.1f   %8.1f   %8.1f   %8.1f\n", num_cores, latencies.percentile(50) / 1000.0,
+                latencies.percentile(90) / 1000.0, latencies.percentile(99) / 1000.0, latencies.max() / 1000.0);
+}
+
+// Every task sweeps the working set of the core it has affinity for, so it
+// runs fast only if that core's thread is still on the CPU whose L1/L2 holds
+// the data. Spinning noise threads give the OS a reason to migrate unpinned
+// workers. Returns sweep throughput in GB/s; counts observed migrations.
+double runPinningBenchmark(const std::vector<int>& cpus, bool pinned, int passes, long long& migrations) {
+    const int workers = static_cast<int>(cpus.size());
+    constexpr size_t WORKING_SET = 192 * 1024; // Fits a typical per-core L2
+    constexpr int TASKS_PER_CORE = 2000;
+    
+    std::vector<std::vector<uint64_t>> working_sets(workers, std::vector<uint64_t>(WORKING_SET / 8, 1));
+    std::vector<std::atomic<int>> last_cpu(workers);
+    for (auto& cpu : last_cpu) cpu = -1;
+    std::atomic<long long> moved{0};
+    std::atomic<uint64_t> sink{0};
+    
+    MultiProcessorScheduler scheduler(workers, false);
+    if (pinned) scheduler.pinToCpus(cpus);
+    std::vector<std::thread> cpu_threads;
+    for (int i = 0; i < workers; i++) {
+        cpu_threads.emplace_back(&MultiProcessorScheduler::cpuScheduler, &scheduler, i);
+    }
+    
+    std::atomic<bool> noise_running{true};
+    std::vector<std::thread> noise;
+    for (int i = 0; i < std::max(workers / 2, 1); i++) {
+        noise.emplace_back([&]() {
+            volatile uint64_t spin = 0;
+            while (noise_running.load(std::memory_order_relaxed)) spin = spin + 1;
+        });
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < TASKS_PER_CORE * workers; t++) {
+        int core = t % workers;
+        Task task(t, 0, core);
+        const std::vector<uint64_t>* data = &working_sets[core];
+        task.body = [data, core, passes, &last_cpu, &moved, &sink]() {
+            int cpu = sched_getcpu();
+            int previous = last_cpu[core].exchange(cpu, std::memory_order_relaxed);
+            if (previous != -1 && previous != cpu) moved.fetch_add(1, std::memory_order_relaxed);
+            
+            uint64_t sum = 0;
+            for (int pass = 0; pass < passes; pass++) {
+                for (uint64_t value : *data) sum += value;
             }
+            sink.fetch_add(sum, std::memory_order_relaxed);
+        };
+        scheduler.addTask(task);
+    }
+    scheduler.waitForCompletion();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    noise_running = false;
+    for (auto& thread : noise) thread.join();
+    scheduler.stop();
+    for (auto& thread : cpu_threads) thread.join();
+    
+    migrations = moved.load();
+    double bytes = static_cast<double>(WORKING_SET) * passes * TASKS_PER_CORE * workers;
+    return bytes / seconds / 1e9;
+}
+
+void benchmarkPinning(std::vector<int> cpus, int passes) {
+    if (cpus.empty()) cpus = MultiProcessorScheduler::allowedCpus();
+    if (cpus.size() > 8) cpus.resize(8);
+    std::cout << "Workers: " << cpus.size() << " (CPUs";
+    for (int cpu : cpus) std::cout << " " << cpu;
+    std::cout << "), " << passes << " sweeps of a 192 KiB working set per task\n\n";
+    std::cout << "Mode        Throughput (GB/s)   Migrations\n";
+    for (bool pinned : {false, true}) {
+        long long migrations = 0;
+        double throughput = runPinningBenchmark(cpus, pinned, passes, migrations);
+        std::printf("%-10s  %17.2f   %10lld\n", pinned ? "pinned" : "unpinned", throughput, migrations);
+    }
+}
+
+// Admission, offline prediction and a measured run of one periodic/sporadic
+// task set under EDF and RM on 1..max_cores cores
+void demoRealTime(int max_cores, int seconds) {
+    std::vector<Task> tasks = {
+        Task::realTime(101, 20, 4),          // 20% of a CPU each
+        Task::realTime(102, 40, 10),
+        Task::realTime(103, 50, 15, 40),     // Constrained deadline
+        Task::realTime(104, 100, 30),
+        Task::realTime(105, 80, 20, 0, true), // Sporadic
+        Task::realTime(106, 200, 50),
+    };
+    double total = 0;
+    for (const Task& task : tasks) total += task.utilization();
+    std::printf("Task set: %zu tasks, total density %.2f\n\n", tasks.size(), total);
+    
+    // Sanity check of the simulator: a single job whose WCET exceeds its
+    // deadline must be the only job counted, and it must count as a miss
+    auto late = MultiProcessorScheduler::simulateRealTime({Task::realTime(100, 100, 10, 5)}, 2, RealTimePolicy::EDF, 1);
+    if (late.jobs != 1 || late.missRate() != 1.0) {
+        std::printf("Simulator check failed: always-late job gave %lld jobs, %.0f%% misses\n", late.jobs,
+                    late.missRate() * 100);
+        return;
+    }
+    
+    std::cout << "Cores  Policy  Bound  Admitted  Predicted miss rate\n";
+    for (int cores = 1; cores <= max_cores; cores *= 2) {
+        for (RealTimePolicy policy : {RealTimePolicy::EDF, RealTimePolicy::RM}) {
+            auto admission = MultiProcessorScheduler::admissionTest(tasks, cores, policy);
+            auto predicted = MultiProcessorScheduler::simulateRealTime(tasks, cores, policy, 10000);
+            std::printf("%5d  %-6s  %5.2f  %-8s  %18.2f%%\n", cores, policy == RealTimePolicy::EDF ? "EDF" : "RM",
+                        admission.bound, admission.admitted ? "yes" : "no", predicted.missRate() * 100);
         }
-        
-        // Find node with lowest memory latency that has available cores
-        int best_node = 0;
-        int min_latency = numa_nodes[0].memory_latency;
-        
-        for (size_t i = 1; i < numa_nodes.size(); i++) {
-            if (numa_nodes[i].memory_latency < min_latency) {
-                min_latency = numa_nodes[i].memory_latency;
-                best_node = static_cast<int>(i);
-            }
+    }
+    
+    for (RealTimePolicy policy : {RealTimePolicy::EDF, RealTimePolicy::RM}) {
+        MultiProcessorScheduler scheduler(max_cores, false);
+        scheduler.setRealTimePolicy(policy);
+        int admitted = 0;
+        for (const Task& task : tasks) {
+            if (scheduler.admitRealTimeTask(task)) admitted++;
         }
+        std::vector<std::thread> cpu_threads;
+        for (int i = 0; i < max_cores; i++) {
+            cpu_threads.emplace_back(&MultiProcessorScheduler::cpuScheduler, &scheduler, i);
+        }
+        scheduler.releaseRealTimeJobs(std::chrono::seconds(seconds));
+        scheduler.waitForCompletion();
+        scheduler.stop();
+        for (auto& thread : cpu_threads) thread.join();
         
-        return numa_nodes[best_node].cpu_cores[0];
+        std::cout << "\nMeasured on " << max_cores << " cores, " << (policy == RealTimePolicy::EDF ? "EDF" : "RM")
+                  << ", " << admitted << "/" << tasks.size() << " tasks admitted, " << seconds << "s:\n";
+        MultiProcessorScheduler::displayRealTimeStats(scheduler.realTimeStats());
+    }
+}
+
+// Usage: multiprocessor_scheduling [--pin cpulist]     runs the scheduler demo, optionally with
+//                                                      worker threads pinned (e.g. --pin 0-3)
+//        multiprocessor_scheduling --bench [depth]     runs the work-stealing contention
+//                                                      benchmark (fork-join tree, default depth 20)
+//        multiprocessor_scheduling --latency [samples] measures idle-core dispatch latency
+//                                                      (default 10000 tasks per core count)
+//        multiprocessor_scheduling --pinning [passes] [cpulist]
+//                                                      compares pinned and unpinned workers on a
+//                                                      cache-sensitive task body (default 8 passes)
+//        multiprocessor_scheduling --realtime [cores] [seconds]
+//                                                      EDF/RM admission, predicted and measured
+//                                                      deadline misses (default 4 cores, 3s)
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--realtime") {
+        int cores = argc > 2 ? std::atoi(argv[2]) : 4;
+        int seconds = argc > 3 ? std::atoi(argv[3]) : 3;
+        std::cout << "Real-Time Scheduling (EDF / RM)\n";
+        std::cout << "===============================\n";
+        demoRealTime(std::max(cores, 1), std::max(seconds, 1));
+        return 0;
     }
     
-    void displayNUMATopology() {
-        std::cout << "\n=== NUMA TOPOLOGY ===\n";
-        for (const auto& node : numa_nodes) {
-            std::cout << "NUMA Node " << node.node_id 
-                      << ": CPUs [";
-            for (size_t i = 0; i < node.cpu_cores.size(); i++) {
-                std::cout << node.cpu_cores[i];
-                if (i < node.cpu_cores.size() - 1) std::cout << ", ";
-            }
-            std::cout << "], Memory Latency: " << node.memory_latency << "ns\n";
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        int depth = argc > 2 ? std::atoi(argv[2]) : 20;
+        std::cout << "Work-Stealing Deque Contention Benchmark\n";
+        std::cout << "========================================\n";
+        benchmarkWorkStealing(depth);
+        return 0;
+    }
+    
+    if (argc > 1 && std::string(argv[1]) == "--latency") {
+        int samples = argc > 2 ? std::atoi(argv[2]) : 10000;
+        std::cout << "Idle-Core Dispatch Latency Benchmark (" << samples << " tasks, half with affinity)\n";
+        std::cout << "=============================================================\n";
+        std::cout << "Cores   p50 (us)   p90 (us)   p99 (us)   max (us)\n";
+        for (int cores : {1, 2, 4, 8}) {
+            benchmarkDispatchLatency(cores, samples);
         }
+        return 0;
     }
-};
-
-int main() {
+    
+    if (argc > 1 && std::string(argv[1]) == "--pinning") {
+        int passes = argc > 2 ? std::atoi(argv[2]) : 8;
+        std::vector<int> cpus = argc > 3 ? NUMAScheduler::parseCpuList(argv[3]) : std::vector<int>{};
+        std::cout << "Pinned vs Unpinned Cache Reuse Benchmark\n";
+        std::cout << "========================================\n";
+        benchmarkPinning(cpus, passes);
+        return 0;
+    }
+    
+    std::vector<int> pin_cpus;
+    if (argc > 2 && std::string(argv[1]) == "--pin") {
+        pin_cpus = NUMAScheduler::parseCpuList(argv[2]);
+    }
+    
     try {
         std::cout << "=== MULTI-PROCESSOR SCHEDULING DEMO ===\n\n";
         
         const int NUM_CORES = 4;
+        NUMAScheduler numa_scheduler = NUMAScheduler::detect(NUM_CORES);
         MultiProcessorScheduler scheduler(NUM_CORES);
+        scheduler.setTopology(numa_scheduler);
+        if (!pin_cpus.empty()) {
+            scheduler.pinToCpus(pin_cpus);
+        }
         
         // Start CPU schedulers
         std::vector<std::thread> cpu_threads;
@@ -323,17 +1650,21 @@ int main() {
         std::mt19937 gen(rd());
         std::uniform_int_distribution<> burst_dist(50, 200);
         std::uniform_int_distribution<> affinity_dist(0, NUM_CORES - 1);
+        std::uniform_int_distribution<> node_dist(0, numa_scheduler.nodeCount() - 1);
         
         std::cout << "Generating tasks...\n";
         for (int i = 1; i <= 12; i++) {
             int burst_time = burst_dist(gen);
             int preferred_cpu = (i % 3 == 0) ? affinity_dist(gen) : -1; // Some tasks have affinity
+            int home_node = (i % 3 == 1) ? node_dist(gen) : -1;          // Some have memory on a node
             
-            Task task(i, burst_time, preferred_cpu);
+            Task task(i, burst_time, preferred_cpu, home_node);
             scheduler.addTask(task);
             
             if (preferred_cpu >= 0) {
                 std::cout << "Added Task " << i << " with CPU affinity to Core " << preferred_cpu << "\n";
+            } else if (home_node >= 0) {
+                std::cout << "Added Task " << i << " with memory on NUMA node " << home_node << "\n";
             } else {
                 std::cout << "Added Task " << i << " without CPU affinity\n";
             }
@@ -347,7 +1678,6 @@ int main() {
         scheduler.displayStats();
         
         // Demonstrate NUMA awareness
-        NUMAScheduler numa_scheduler;
         numa_scheduler.displayNUMATopology();
         
         std::cout << "\nOptimal core for NUMA node 0: " << numa_scheduler.selectOptimalCore(0) << "\n";
@@ -11,6 +11,19 @@
 #include <mutex>
 #include <condition_variable>
 #include <random>
+#include <string>
+#include <stdexcept>
+#include <cstdio>
+#include <climits>
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 using namespace std;
 using namespace std::chrono;
@@ -56,6 +69,262 @@ public:
     }
 };
 
+//=============================================================================
+// LIGHTWEIGHT SEMAPHORE (Linux futex)
+//=============================================================================
+
+// Same interface as Semaphore, but acquire/release are a single CAS or
+// fetch_add while permits are available. Only a thread that finds the count
+// at zero enters the kernel, sleeping on the count itself with FUTEX_WAIT;
+// release only calls FUTEX_WAKE when someone is registered as waiting.
+// Each lab file builds on its own, so lab6/dinning-philosophers.cpp keeps a
+// copy of this class; a fix to one belongs in the other as well.
+class FastSemaphore
+{
+private:
+    static_assert(sizeof(atomic<int>) == sizeof(int), "futex word must be a plain int");
+
+    atomic<int> count;
+    atomic<int> waiters{0};
+    static const int SPIN_LIMIT = 64; // Re-checks before sleeping, for short hold times
+
+    bool try_decrement()
+    {
+        int c = count.load(memory_order_relaxed);
+        while (c > 0)
+        {
+            if (count.compare_exchange_weak(c, c - 1, memory_order_acquire, memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+public:
+    explicit FastSemaphore(int initial_count) : count(initial_count) {}
+
+    void acquire()
+    {
+        if (try_decrement())
+            return;
+        for (int i = 0; i < SPIN_LIMIT; ++i)
+        {
+            if (count.load(memory_order_relaxed) > 0 && try_decrement())
+                return;
+        }
+
+        // Register before the last check: release() either sees the waiter
+        // or we see its permit (both sides are seq_cst, Dekker style)
+        waiters.fetch_add(1);
+        while (!try_decrement())
+        {
+            // Sleeps only if the count is still 0 when the kernel looks
+            syscall(SYS_futex, reinterpret_cast<int *>(&count), FUTEX_WAIT_PRIVATE, 0, nullptr, nullptr, 0);
+        }
+        waiters.fetch_sub(1, memory_order_relaxed);
+    }
+
+    // Hands out n permits at once and wakes at most n sleepers
+    void release(int n = 1)
+    {
+        count.fetch_add(n);
+        int sleeping = waiters.load();
+        if (sleeping > 0)
+        {
+            syscall(SYS_futex, reinterpret_cast<int *>(&count), FUTEX_WAKE_PRIVATE, min(n, sleeping),
+                    nullptr, nullptr, 0);
+        }
+    }
+
+    bool try_acquire()
+    {
+        return try_decrement();
+    }
+};
+
+//=============================================================================
+// LOCK-FREE BOUNDED MPMC QUEUE (Vyukov)
+//=============================================================================
+
+// Bounded multi-producer/multi-consumer ring. Each slot carries a sequence
+// number telling whose turn it is: slot i is free for the producer holding
+// ticket i when seq == i, and full for the consumer holding ticket i when
+// seq == i + 1. Producers and consumers claim tickets with a CAS on their own
+// counter and never touch a lock. Capacity is rounded up to a power of two.
+// Each lab file builds on its own, so lab3/advanced/lab3-2Producer-consumer.cpp
+// keeps a copy of this class; a fix to one belongs in the other as well.
+template <typename T>
+class MPMCQueue
+{
+private:
+    static const size_t CACHE_LINE = 64;
+
+    struct Cell
+    {
+        atomic<size_t> sequence;
+        T data;
+    };
+
+    unique_ptr<Cell[]> cells;
+    size_t mask;
+    size_t limit; // Logical capacity; the ring itself is rounded up to a power of two
+    // Producers and consumers each hammer their own counter; keep them (and the
+    // wakeup words) on separate cache lines so they do not invalidate each other
+    alignas(CACHE_LINE) atomic<size_t> enqueue_pos{0};
+    alignas(CACHE_LINE) atomic<size_t> dequeue_pos{0};
+    alignas(CACHE_LINE) atomic<int> items_epoch{0};  // Bumped when an item arrives for a parked consumer
+    atomic<int> consumers_parked{0};
+    alignas(CACHE_LINE) atomic<int> space_epoch{0};  // Bumped when a slot frees up for a parked producer
+    atomic<int> producers_parked{0};
+
+    static const int SPIN_LIMIT = 128;
+    static const int YIELD_LIMIT = 16;
+
+    static void futex_wait(atomic<int> &word, int expected)
+    {
+        syscall(SYS_futex, reinterpret_cast<int *>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+    }
+
+    // Called after a successful push/pop. The fence pairs with the one in park():
+    // either we see the parked thread, or it sees our item/slot on its re-check.
+    static void wake_one(atomic<int> &epoch, atomic<int> &parked)
+    {
+        atomic_thread_fence(memory_order_seq_cst);
+        if (parked.load(memory_order_relaxed) > 0)
+        {
+            epoch.fetch_add(1, memory_order_relaxed);
+            syscall(SYS_futex, reinterpret_cast<int *>(&epoch), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+        }
+    }
+
+    // Spins, yields, then sleeps until attempt() succeeds. Yielding first lets
+    // the other side refill/drain without either paying for a futex syscall.
+    template <typename Attempt>
+    void park_until(Attempt attempt, atomic<int> &epoch, atomic<int> &parked)
+    {
+        for (int i = 0; i < SPIN_LIMIT + YIELD_LIMIT; ++i)
+        {
+            if (attempt())
+                return;
+            if (i >= SPIN_LIMIT)
+                this_thread::yield();
+        }
+        while (true)
+        {
+            int seen = epoch.load(memory_order_relaxed);
+            parked.fetch_add(1, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            bool done = attempt();
+            if (!done)
+                futex_wait(epoch, seen); // Returns at once if a wake bumped the epoch since
+            parked.fetch_sub(1, memory_order_relaxed);
+            if (done || attempt())
+                return;
+        }
+    }
+
+public:
+    explicit MPMCQueue(size_t capacity) : limit(max<size_t>(capacity, 1))
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; ++i)
+            cells[i].sequence.store(i, memory_order_relaxed);
+    }
+
+    MPMCQueue(const MPMCQueue &) = delete;
+    MPMCQueue &operator=(const MPMCQueue &) = delete;
+
+    // Returns false if the queue is full
+    bool try_push(const T &value)
+    {
+        size_t pos = enqueue_pos.load(memory_order_relaxed);
+        while (true)
+        {
+            Cell &cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                // Full at the logical capacity, not just when the rounded-up ring is
+                if (static_cast<intptr_t>(pos - dequeue_pos.load(memory_order_relaxed)) >=
+                    static_cast<intptr_t>(limit))
+                    return false;
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+                {
+                    cell.data = value;
+                    cell.sequence.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // Slot still holds an item from one lap ago
+            }
+            else
+            {
+                pos = enqueue_pos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    // Returns false if the queue is empty
+    bool try_pop(T &value)
+    {
+        size_t pos = dequeue_pos.load(memory_order_relaxed);
+        while (true)
+        {
+            Cell &cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+                {
+                    value = std::move(cell.data);
+                    cell.sequence.store(pos + mask + 1, memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // Producer for this slot has not finished yet
+            }
+            else
+            {
+                pos = dequeue_pos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    // Blocking wrappers: lock-free while there is room/data, park on a futex
+    // only when the queue is full (push) or empty (pop)
+    void push(const T &value)
+    {
+        park_until([&]
+                   { return try_push(value); },
+                   space_epoch, producers_parked);
+        wake_one(items_epoch, consumers_parked);
+    }
+
+    T pop()
+    {
+        T value;
+        park_until([&]
+                   { return try_pop(value); },
+                   items_epoch, consumers_parked);
+        wake_one(space_epoch, producers_parked);
+        return value;
+    }
+
+    size_t capacity() const
+    {
+        return limit;
+    }
+};
+
 //=============================================================================
 // 1. DEMONSTRATING RACE CONDITIONS (Section 6.1)
 //=============================================================================
@@ -164,6 +433,204 @@ bool PetersonSolution::flag[2] = {false, false};
 int PetersonSolution::turn = 0;
 int PetersonSolution::shared_data = 0;
 
+//=============================================================================
+// SPINLOCK LIBRARY
+//=============================================================================
+
+// All locks below have the same lock()/unlock() interface (BasicLockable),
+// so any of them works with lock_guard and with the templated demos and
+// benchmarks. A waiter spins with `pause` and falls back to yielding after a
+// while, so a lock whose holder has been preempted does not burn a whole
+// time slice. The FIFO locks (ticket, MCS) still collapse once there are more
+// threads than CPUs: the next thread in line may be descheduled.
+
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+class SpinWait
+{
+private:
+    int spins = 0;
+    static const int YIELD_AFTER = 100;
+
+public:
+    void wait()
+    {
+        if (++spins < YIELD_AFTER)
+            cpu_relax();
+        else
+            this_thread::yield();
+    }
+};
+
+// Plain test-and-set: every waiter hammers the line with exchange()
+class TASLock
+{
+private:
+    atomic<bool> locked{false};
+
+public:
+    void lock()
+    {
+        SpinWait spin;
+        while (locked.exchange(true, memory_order_acquire))
+            spin.wait();
+    }
+
+    void unlock()
+    {
+        locked.store(false, memory_order_release);
+    }
+};
+
+// Test-and-test-and-set: waiters spin on a shared (read-only) copy of the
+// line and only try the exchange once it looks free; after a failed attempt
+// they back off exponentially so they do not all retry at once
+class TTASLock
+{
+private:
+    alignas(64) atomic<bool> locked{false};
+    static const int MIN_BACKOFF = 4; // pause instructions
+    static const int MAX_BACKOFF = 1024;
+
+public:
+    void lock()
+    {
+        int backoff = MIN_BACKOFF;
+        SpinWait spin;
+        while (true)
+        {
+            while (locked.load(memory_order_relaxed))
+                spin.wait();
+            if (!locked.exchange(true, memory_order_acquire))
+                return;
+            for (int i = 0; i < backoff; ++i)
+                cpu_relax();
+            backoff = min(backoff * 2, MAX_BACKOFF);
+        }
+    }
+
+    void unlock()
+    {
+        locked.store(false, memory_order_release);
+    }
+};
+
+// FIFO ticket lock: take a number, wait until it is served. Waiters back off
+// in proportion to how far they are from the front of the line.
+class TicketLock
+{
+private:
+    alignas(64) atomic<unsigned> next_ticket{0};
+    alignas(64) atomic<unsigned> now_serving{0};
+    static const int BACKOFF_PER_WAITER = 32; // pause instructions
+
+public:
+    void lock()
+    {
+        unsigned ticket = next_ticket.fetch_add(1, memory_order_relaxed);
+        SpinWait spin;
+        while (true)
+        {
+            unsigned ahead = ticket - now_serving.load(memory_order_acquire);
+            if (ahead == 0)
+                return;
+            if (ahead > 1)
+            {
+                for (unsigned i = 0; i < (ahead - 1) * BACKOFF_PER_WAITER; ++i)
+                    cpu_relax();
+            }
+            spin.wait();
+        }
+    }
+
+    void unlock()
+    {
+        // Only the holder writes now_serving, so a plain increment is enough
+        now_serving.store(now_serving.load(memory_order_relaxed) + 1, memory_order_release);
+    }
+};
+
+// MCS queue lock (Mellor-Crummey & Scott): waiters form a linked queue and
+// each spins on the `locked` flag in its own cache-line-sized node, so a
+// release touches exactly one waiter's line. Nodes come from a small
+// per-thread stack, so a thread may hold several MCS locks at once as long as
+// it releases them in reverse order.
+class MCSLock
+{
+private:
+    struct alignas(64) Node
+    {
+        atomic<Node *> next{nullptr};
+        atomic<bool> locked{false};
+    };
+
+    struct ThreadNodes
+    {
+        static const int MAX_NESTING = 8;
+        Node nodes[MAX_NESTING];
+        int depth = 0;
+    };
+
+    static ThreadNodes &thread_nodes()
+    {
+        thread_local ThreadNodes nodes;
+        return nodes;
+    }
+
+    alignas(64) atomic<Node *> tail{nullptr};
+    Node *holder = nullptr; // Node of the current owner; only the owner touches it
+
+public:
+    void lock()
+    {
+        ThreadNodes &mine = thread_nodes();
+        if (mine.depth == ThreadNodes::MAX_NESTING)
+            throw runtime_error("MCSLock: a thread may hold at most " +
+                                to_string(ThreadNodes::MAX_NESTING) + " MCS locks at once");
+        Node *node = &mine.nodes[mine.depth++];
+        node->next.store(nullptr, memory_order_relaxed);
+        node->locked.store(true, memory_order_relaxed);
+
+        Node *pred = tail.exchange(node, memory_order_acq_rel);
+        if (pred)
+        {
+            pred->next.store(node, memory_order_release);
+            SpinWait spin;
+            while (node->locked.load(memory_order_acquire))
+                spin.wait();
+        }
+        holder = node;
+    }
+
+    void unlock()
+    {
+        Node *node = holder;
+        Node *succ = node->next.load(memory_order_acquire);
+        if (!succ)
+        {
+            Node *expected = node;
+            if (tail.compare_exchange_strong(expected, nullptr, memory_order_release, memory_order_relaxed))
+            {
+                thread_nodes().depth--;
+                return;
+            }
+            // A successor swapped itself into tail but has not linked in yet
+            SpinWait spin;
+            while (!(succ = node->next.load(memory_order_acquire)))
+                spin.wait();
+        }
+        succ->locked.store(false, memory_order_release);
+        thread_nodes().depth--;
+    }
+};
+
 //=============================================================================
 // 3. HARDWARE INSTRUCTIONS (Section 6.4)
 //=============================================================================
@@ -251,6 +718,34 @@ public:
         cout << "Compare-and-Swap result: " << cas_counter.load() << endl;
         cout << "Compare-and-Swap: " << (cas_counter.load() == 2 * ITERATIONS ? "SUCCESS" : "FAILED") << endl;
     }
+
+    // The test-and-set demo again, with any lock from the spinlock library
+    template <typename Lock>
+    static void demonstrate_lock(const char *name)
+    {
+        cout << "\n=== " << name << " LOCK DEMONSTRATION ===" << endl;
+        Lock lock;
+        int counter = 0;
+
+        auto locked_increment = [&lock, &counter]()
+        {
+            for (int i = 0; i < ITERATIONS; ++i)
+            {
+                lock_guard<Lock> guard(lock);
+                counter++;
+            }
+        };
+
+        thread t1(locked_increment);
+        thread t2(locked_increment);
+
+        t1.join();
+        t2.join();
+
+        cout << "Expected result: " << (2 * ITERATIONS) << endl;
+        cout << name << " result: " << counter << endl;
+        cout << name << ": " << (counter == 2 * ITERATIONS ? "SUCCESS" : "FAILED") << endl;
+    }
 };
 
 atomic<bool> HardwareInstructions::lock_var{false};
@@ -305,7 +800,7 @@ int MutexDemo::shared_counter = 0;
 class SemaphoreDemo
 {
 private:
-    static Semaphore resource_semaphore;
+    static FastSemaphore resource_semaphore;
 
     static void process_task(int process_id)
     {
@@ -343,7 +838,7 @@ public:
     }
 };
 
-Semaphore SemaphoreDemo::resource_semaphore{3}; // 3 resources available
+FastSemaphore SemaphoreDemo::resource_semaphore{3}; // 3 resources available
 
 //=============================================================================
 // 6. PRODUCER-CONSUMER PROBLEM (Sections 6.1, 6.6)
@@ -358,6 +853,9 @@ private:
     static mutex buffer_mutex;
     static condition_variable not_empty, not_full;
     static bool done;
+    // Alternative buffer: the same 10 slots as a lock-free MPMC ring
+    static MPMCQueue<int> ring;
+    static bool use_ring;
 
 public:
     static void producer(int producer_id)
@@ -370,6 +868,14 @@ public:
         {
             int item = dis(gen);
 
+            if (use_ring)
+            {
+                ring.push(item); // Blocks only while the ring is full
+                cout << "Producer " << producer_id << " produced: " << item << endl;
+                this_thread::sleep_for(milliseconds(100));
+                continue;
+            }
+
             unique_lock<mutex> lock(buffer_mutex);
             not_full.wait(lock, []
                           { return count < BUFFER_SIZE; });
@@ -392,6 +898,14 @@ public:
     {
         for (int i = 0; i < 5; ++i)
         {
+            if (use_ring)
+            {
+                int item = ring.pop(); // Blocks only while the ring is empty
+                cout << "Consumer " << consumer_id << " consumed: " << item << endl;
+                this_thread::sleep_for(milliseconds(150));
+                continue;
+            }
+
             unique_lock<mutex> lock(buffer_mutex);
             not_empty.wait(lock, []
                            { return count > 0 || done; });
@@ -414,12 +928,14 @@ public:
         }
     }
 
-    static void demonstrate_producer_consumer()
+    static void demonstrate_producer_consumer(bool lock_free = false)
     {
         cout << "\n=== PRODUCER-CONSUMER DEMONSTRATION ===" << endl;
+        cout << "Buffer: " << (lock_free ? "lock-free MPMC ring" : "mutex + condition variables") << endl;
 
         in = out = count = 0;
         done = false;
+        use_ring = lock_free;
 
         vector<thread> threads;
 
@@ -449,6 +965,299 @@ mutex ProducerConsumer::buffer_mutex;
 condition_variable ProducerConsumer::not_empty;
 condition_variable ProducerConsumer::not_full;
 bool ProducerConsumer::done = false;
+MPMCQueue<int> ProducerConsumer::ring(ProducerConsumer::BUFFER_SIZE);
+bool ProducerConsumer::use_ring = false;
+
+//=============================================================================
+// LOCK CONTENTION PROFILER
+//=============================================================================
+// ProfiledMutex and ProfiledCondVar replace mutex and condition_variable and
+// record, per lock name, how often the lock was taken, how often a thread had
+// to block, and wait / hold time histograms. Counters go to a thread-local
+// buffer (no shared cache line on the lock path) that is merged into the
+// totals when the thread exits; the hottest locks are printed at exit.
+// Each lab file builds on its own, so lab6/dinning-philosophers.cpp keeps a copy of
+// these three classes; a fix to one belongs in the other as well.
+class LockProfiler
+{
+public:
+    static const int BUCKETS = 8; // <100ns <1us <10us <100us <1ms <10ms <100ms >=100ms
+
+    struct Stats
+    {
+        long long acquisitions = 0; // lock() / try_lock() successes, or condvar waits
+        long long contended = 0;    // of those, how many had to block
+        long long timeouts = 0;     // timed attempts that gave up
+        long long total_wait_ns = 0;
+        long long max_wait_ns = 0;
+        long long total_hold_ns = 0;
+        long long wait_histogram[BUCKETS] = {};
+        long long hold_histogram[BUCKETS] = {};
+
+        void record_wait(long long ns, bool blocked)
+        {
+            acquisitions++;
+            if (blocked) contended++;
+            add_wait(ns);
+        }
+
+        void record_timeout(long long ns)
+        {
+            timeouts++;
+            add_wait(ns);
+        }
+
+        void record_hold(long long ns)
+        {
+            total_hold_ns += ns;
+            hold_histogram[bucket(ns)]++;
+        }
+
+        void add_wait(long long ns)
+        {
+            total_wait_ns += ns;
+            max_wait_ns = max(max_wait_ns, ns);
+            wait_histogram[bucket(ns)]++;
+        }
+
+        void merge(const Stats &other)
+        {
+            acquisitions += other.acquisitions;
+            contended += other.contended;
+            timeouts += other.timeouts;
+            total_wait_ns += other.total_wait_ns;
+            max_wait_ns = max(max_wait_ns, other.max_wait_ns);
+            total_hold_ns += other.total_hold_ns;
+            for (int b = 0; b < BUCKETS; ++b)
+            {
+                wait_histogram[b] += other.wait_histogram[b];
+                hold_histogram[b] += other.hold_histogram[b];
+            }
+        }
+    };
+
+    static LockProfiler &instance()
+    {
+        static LockProfiler profiler; // destroyed after every thread's buffer has been merged
+        return profiler;
+    }
+
+    // This thread's counters for a lock; only valid until the next call
+    static Stats &local(int id)
+    {
+        thread_local ThreadBuffer buffer;
+        if (id >= (int)buffer.stats.size()) buffer.stats.resize(id + 1);
+        return buffer.stats[id];
+    }
+
+    static long long nanos(steady_clock::duration d)
+    {
+        return duration_cast<nanoseconds>(d).count();
+    }
+
+    static int bucket(long long ns)
+    {
+        int b = 0;
+        for (long long limit = 100; b < BUCKETS - 1 && ns >= limit; limit *= 10) b++;
+        return b;
+    }
+
+    // Locks with the same name share one entry
+    int register_lock(const string &name, const char *kind)
+    {
+        lock_guard<mutex> lock(registry_mutex);
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            if (names[i] == name) return (int)i;
+        }
+        names.push_back(name);
+        kinds.push_back(kind);
+        totals.push_back(Stats());
+        return (int)names.size() - 1;
+    }
+
+    void merge(const vector<Stats> &stats)
+    {
+        lock_guard<mutex> lock(registry_mutex);
+        for (size_t i = 0; i < stats.size() && i < totals.size(); ++i)
+        {
+            totals[i].merge(stats[i]);
+        }
+    }
+
+    // Locks sorted by total time threads spent waiting for them
+    void report(size_t histograms = 3)
+    {
+        lock_guard<mutex> lock(registry_mutex);
+        vector<int> order;
+        for (size_t i = 0; i < totals.size(); ++i)
+        {
+            if (totals[i].acquisitions + totals[i].timeouts > 0) order.push_back((int)i);
+        }
+        if (order.empty()) return;
+        sort(order.begin(), order.end(), [this](int a, int b)
+             { return totals[a].total_wait_ns > totals[b].total_wait_ns; });
+
+        cout << "\n=== LOCK CONTENTION REPORT (hottest first) ===" << endl;
+        printf("%-34s %-7s %9s %9s %8s %13s %12s %12s %12s\n", "Lock", "Kind", "Count", "Contended",
+               "Timeouts", "Total wait ms", "Avg wait us", "Max wait ms", "Avg hold us");
+        for (size_t k = 0; k < order.size(); ++k)
+        {
+            const Stats &s = totals[order[k]];
+            long long attempts = s.acquisitions + s.timeouts;
+            char hold[32] = "-";
+            if (kinds[order[k]] == "mutex" && s.acquisitions > 0)
+            {
+                snprintf(hold, sizeof(hold), "%.1f", s.total_hold_ns / 1e3 / s.acquisitions);
+            }
+            printf("%-34s %-7s %9lld %8.1f%% %8lld %13.3f %12.1f %12.3f %12s\n", names[order[k]].c_str(),
+                   kinds[order[k]].c_str(), s.acquisitions, 100.0 * s.contended / max(s.acquisitions, 1LL),
+                   s.timeouts, s.total_wait_ns / 1e6, s.total_wait_ns / 1e3 / attempts, s.max_wait_ns / 1e6, hold);
+        }
+
+        static const char *labels[BUCKETS] = {"<100ns", "<1us", "<10us", "<100us", "<1ms", "<10ms", "<100ms", ">=100ms"};
+        for (size_t k = 0; k < order.size() && k < histograms; ++k)
+        {
+            const Stats &s = totals[order[k]];
+            cout << "\n" << names[order[k]] << endl;
+            cout << "  wait:";
+            for (int b = 0; b < BUCKETS; ++b) cout << " " << labels[b] << "=" << s.wait_histogram[b];
+            cout << endl;
+            if (kinds[order[k]] == "mutex")
+            {
+                cout << "  hold:";
+                for (int b = 0; b < BUCKETS; ++b) cout << " " << labels[b] << "=" << s.hold_histogram[b];
+                cout << endl;
+            }
+        }
+    }
+
+    ~LockProfiler()
+    {
+        report();
+    }
+
+private:
+    struct ThreadBuffer
+    {
+        vector<Stats> stats;
+        ~ThreadBuffer() { LockProfiler::instance().merge(stats); }
+    };
+
+    LockProfiler() {}
+
+    mutex registry_mutex;
+    vector<string> names;
+    vector<string> kinds;
+    vector<Stats> totals;
+};
+
+// Drop-in for mutex (lock / try_lock / unlock), usable with lock_guard and unique_lock
+class ProfiledMutex
+{
+private:
+    mutex mtx;
+    int id;
+    steady_clock::time_point acquired_at; // written and read by the owner only
+
+public:
+    explicit ProfiledMutex(const string &name = "unnamed mutex")
+        : id(LockProfiler::instance().register_lock(name, "mutex")) {}
+    ProfiledMutex(const ProfiledMutex &) = delete;
+    ProfiledMutex &operator=(const ProfiledMutex &) = delete;
+
+    // Arrays of locks can only be default-constructed, so they are named afterwards
+    void set_name(const string &name)
+    {
+        id = LockProfiler::instance().register_lock(name, "mutex");
+    }
+
+    void lock()
+    {
+        if (mtx.try_lock()) // uncontended: no wait to time
+        {
+            acquired_at = steady_clock::now();
+            LockProfiler::local(id).record_wait(0, false);
+            return;
+        }
+        auto start = steady_clock::now();
+        mtx.lock();
+        acquired_at = steady_clock::now();
+        LockProfiler::local(id).record_wait(LockProfiler::nanos(acquired_at - start), true);
+    }
+
+    bool try_lock()
+    {
+        if (!mtx.try_lock()) return false;
+        acquired_at = steady_clock::now();
+        LockProfiler::local(id).record_wait(0, false);
+        return true;
+    }
+
+    // Polls try_lock until the timeout (mutex has no timed lock); the polling counts as waiting
+    bool try_lock_for(milliseconds timeout)
+    {
+        if (try_lock()) return true;
+        auto start = steady_clock::now();
+        while (steady_clock::now() - start < timeout)
+        {
+            this_thread::sleep_for(milliseconds(10)); // Small sleep to prevent busy waiting
+            if (mtx.try_lock())
+            {
+                acquired_at = steady_clock::now();
+                LockProfiler::local(id).record_wait(LockProfiler::nanos(acquired_at - start), true);
+                return true;
+            }
+        }
+        LockProfiler::local(id).record_timeout(LockProfiler::nanos(steady_clock::now() - start));
+        return false;
+    }
+
+    void unlock()
+    {
+        long long held = LockProfiler::nanos(steady_clock::now() - acquired_at);
+        mtx.unlock();
+        LockProfiler::local(id).record_hold(held);
+    }
+};
+
+// condition_variable_any that records how long each wait blocked
+class ProfiledCondVar
+{
+private:
+    condition_variable_any cv;
+    int id;
+
+public:
+    explicit ProfiledCondVar(const string &name = "unnamed condvar")
+        : id(LockProfiler::instance().register_lock(name, "condvar")) {}
+
+    template <typename Lock>
+    void wait(Lock &lock)
+    {
+        auto start = steady_clock::now();
+        cv.wait(lock);
+        LockProfiler::local(id).record_wait(LockProfiler::nanos(steady_clock::now() - start), true);
+    }
+
+    template <typename Lock, typename Predicate>
+    void wait(Lock &lock, Predicate ready)
+    {
+        while (!ready()) wait(lock);
+    }
+
+    void notify_one() { cv.notify_one(); }
+    void notify_all() { cv.notify_all(); }
+};
+
+// Names locks[0..n-1] "<prefix>[i]"
+static void name_locks(ProfiledMutex *locks, int n, const string &prefix)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        locks[i].set_name(prefix + "[" + to_string(i) + "]");
+    }
+}
 
 //=============================================================================
 // 7. MONITOR IMPLEMENTATION (Section 6.7)
@@ -457,22 +1266,49 @@ bool ProducerConsumer::done = false;
 class Monitor
 {
 private:
-    mutable mutex monitor_mutex;
-    condition_variable condition_x;
+    mutable ProfiledMutex monitor_mutex;
+    ProfiledCondVar condition_x;
     int x_count = 0;
 
+    // The monitor lock this thread holds through execute(), so that wait_x()
+    // and signal_x() called from inside it do not lock monitor_mutex again
+    struct Inside
+    {
+        const Monitor *monitor;
+        unique_lock<ProfiledMutex> *lock;
+    };
+    static thread_local Inside inside;
+
+    unique_lock<ProfiledMutex> *held_lock() const
+    {
+        return inside.monitor == this ? inside.lock : nullptr;
+    }
+
 public:
+    explicit Monitor(const string &name = "Monitor")
+        : monitor_mutex(name + "::monitor_mutex"), condition_x(name + "::condition_x") {}
+
     void wait_x()
     {
-        unique_lock<mutex> lock(monitor_mutex);
+        unique_lock<ProfiledMutex> own(monitor_mutex, defer_lock);
+        unique_lock<ProfiledMutex> *lock = held_lock();
+        if (!lock)
+        {
+            own.lock();
+            lock = &own;
+        }
         x_count++;
-        condition_x.wait(lock);
+        condition_x.wait(*lock);
         x_count--;
     }
 
     void signal_x()
     {
-        unique_lock<mutex> lock(monitor_mutex);
+        unique_lock<ProfiledMutex> own(monitor_mutex, defer_lock);
+        if (!held_lock())
+        {
+            own.lock();
+        }
         if (x_count > 0)
         {
             condition_x.notify_one();
@@ -482,15 +1318,23 @@ public:
     template <typename Func>
     auto execute(Func &&func) -> decltype(func())
     {
-        unique_lock<mutex> lock(monitor_mutex);
+        unique_lock<ProfiledMutex> lock(monitor_mutex);
+        struct Restore
+        {
+            Inside previous;
+            ~Restore() { inside = previous; }
+        } restore{inside};
+        inside = Inside{this, &lock};
         return func();
     }
 };
 
+thread_local Monitor::Inside Monitor::inside = {nullptr, nullptr};
+
 class ResourceAllocator
 {
 private:
-    Monitor monitor;
+    Monitor monitor{"ResourceAllocator"};
     bool busy = false;
     condition_variable resource_available;
 
@@ -554,7 +1398,7 @@ class DiningPhilosophers
 {
 private:
     static const int NUM_PHILOSOPHERS = 5;
-    static mutex chopsticks[NUM_PHILOSOPHERS];
+    static ProfiledMutex chopsticks[NUM_PHILOSOPHERS];
 
     static void philosopher(int id)
     {
@@ -594,6 +1438,7 @@ public:
     static void demonstrate_dining_philosophers()
     {
         cout << "\n=== DINING PHILOSOPHERS DEMONSTRATION ===" << endl;
+        name_locks(chopsticks, NUM_PHILOSOPHERS, "DiningPhilosophers::chopsticks");
 
         vector<thread> philosophers;
 
@@ -611,14 +1456,249 @@ public:
     }
 };
 
-mutex DiningPhilosophers::chopsticks[DiningPhilosophers::NUM_PHILOSOPHERS];
+ProfiledMutex DiningPhilosophers::chopsticks[DiningPhilosophers::NUM_PHILOSOPHERS];
+
+//=============================================================================
+// SEMAPHORE MICROBENCHMARK
+//=============================================================================
+
+// Every thread does acquire/release pairs on one semaphore with `permits`
+// permits; returns pairs per second across all threads
+template <typename Sem>
+double semaphore_throughput(int threads, int permits, int pairs_per_thread)
+{
+    Sem sem(permits);
+    atomic<int> ready{0};
+    atomic<bool> go{false};
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&]()
+                             {
+            ready++;
+            while (!go.load()) this_thread::yield();
+            for (int i = 0; i < pairs_per_thread; ++i) {
+                sem.acquire();
+                sem.release();
+            } });
+    }
+    while (ready.load() < threads)
+        this_thread::yield();
+    auto start = steady_clock::now();
+    go = true;
+    for (auto &w : workers)
+        w.join();
+    double elapsed = duration<double>(steady_clock::now() - start).count();
+    return threads * static_cast<double>(pairs_per_thread) / elapsed;
+}
+
+// Every thread takes the lock in a loop for `window`, doing a short critical
+// section (a few increments of shared data). Prints total acquisitions/sec and
+// two fairness figures over the per-thread counts: Jain's index (1.0 = all
+// equal, 1/n = one thread got everything) and the min/max ratio.
+template <typename Lock>
+void lock_contention(const char *name, int threads, milliseconds window)
+{
+    Lock lock;
+    volatile long shared_data[4] = {0, 0, 0, 0};
+    vector<long long> counts(threads, 0);
+    atomic<int> ready{0};
+    atomic<bool> go{false}, stop{false};
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]()
+                             {
+            long long acquired = 0;
+            ready++;
+            while (!go.load()) this_thread::yield();
+            while (!stop.load(memory_order_relaxed)) {
+                lock.lock();
+                for (int i = 0; i < 4; ++i) shared_data[i] = shared_data[i] + 1;
+                lock.unlock();
+                acquired++;
+            }
+            counts[t] = acquired; });
+    }
+    while (ready.load() < threads)
+        this_thread::yield();
+    auto start = steady_clock::now();
+    go = true;
+    this_thread::sleep_for(window);
+    stop = true;
+    for (auto &w : workers)
+        w.join();
+    double elapsed = duration<double>(steady_clock::now() - start).count();
+
+    double sum = 0, sum_sq = 0;
+    long long least = LLONG_MAX, most = 0;
+    for (long long c : counts)
+    {
+        sum += c;
+        sum_sq += static_cast<double>(c) * c;
+        least = min(least, c);
+        most = max(most, c);
+    }
+    double jain = sum_sq > 0 ? sum * sum / (threads * sum_sq) : 1.0;
+    bool consistent = shared_data[0] == static_cast<long>(sum);
+    printf("%-8s %7d   %14.0f   %10.3f   %10.3f%s\n", name, threads, sum / elapsed, jain,
+           most > 0 ? static_cast<double>(least) / most : 1.0, consistent ? "" : "   LOST UPDATES");
+}
+
+void benchmark_locks(const string &only)
+{
+    const milliseconds WINDOW(200);
+    cout << "\n=== SPINLOCK CONTENTION BENCHMARK (" << WINDOW.count() << "ms per run) ===" << endl;
+    cout << "Lock     Threads   Acquisitions/s   Jain index   Min/Max" << endl;
+    for (int threads : {1, 2, 4, 8, 16, 32, 64, 128})
+    {
+        if (only.empty() || only == "tas")
+            lock_contention<TASLock>("TAS", threads, WINDOW);
+        if (only.empty() || only == "ttas")
+            lock_contention<TTASLock>("TTAS", threads, WINDOW);
+        if (only.empty() || only == "ticket")
+            lock_contention<TicketLock>("Ticket", threads, WINDOW);
+        if (only.empty() || only == "mcs")
+            lock_contention<MCSLock>("MCS", threads, WINDOW);
+        if (only.empty() || only == "mutex")
+            lock_contention<mutex>("mutex", threads, WINDOW);
+    }
+}
+
+void benchmark_semaphores()
+{
+    const int PAIRS = 200000;
+    cout << "\n=== SEMAPHORE BENCHMARK (acquire+release pairs/sec) ===" << endl;
+    cout << "Uncontended: one permit per thread. Contended: half as many permits as threads." << endl;
+    cout << "Threads   mutex+cv (uncont.)   futex (uncont.)   mutex+cv (cont.)   futex (cont.)" << endl;
+    for (int threads : {1, 2, 4, 8, 16, 32, 64})
+    {
+        int pairs = max(PAIRS / threads, 1000);
+        double old_free = semaphore_throughput<Semaphore>(threads, threads, pairs);
+        double fast_free = semaphore_throughput<FastSemaphore>(threads, threads, pairs);
+        double old_busy = semaphore_throughput<Semaphore>(threads, max(threads / 2, 1), pairs);
+        double fast_busy = semaphore_throughput<FastSemaphore>(threads, max(threads / 2, 1), pairs);
+        printf("%7d   %18.0f   %15.0f   %16.0f   %13.0f\n", threads, old_free, fast_free, old_busy, fast_busy);
+    }
+}
+
+//=============================================================================
+// BOUNDED BUFFER BENCHMARK
+//=============================================================================
+
+// ProducerConsumer's original design as a reusable class: one mutex and
+// two condition variables around a circular buffer
+class MutexBoundedBuffer
+{
+private:
+    vector<int> buffer;
+    size_t in = 0, out = 0, count = 0;
+    mutex buffer_mutex;
+    condition_variable not_empty, not_full;
+
+public:
+    explicit MutexBoundedBuffer(size_t capacity) : buffer(capacity) {}
+
+    void push(int item)
+    {
+        unique_lock<mutex> lock(buffer_mutex);
+        not_full.wait(lock, [this]
+                      { return count < buffer.size(); });
+        buffer[in] = item;
+        in = (in + 1) % buffer.size();
+        count++;
+        not_empty.notify_one();
+    }
+
+    int pop()
+    {
+        unique_lock<mutex> lock(buffer_mutex);
+        not_empty.wait(lock, [this]
+                       { return count > 0; });
+        int item = buffer[out];
+        out = (out + 1) % buffer.size();
+        count--;
+        not_full.notify_one();
+        return item;
+    }
+};
+
+// Moves items_per_producer items from each producer to the consumers (which
+// split them evenly); returns items per second
+template <typename Queue>
+double queue_throughput(int producers, int consumers, int items_per_producer, size_t capacity)
+{
+    Queue queue(capacity);
+    long long total = static_cast<long long>(producers) * items_per_producer;
+    atomic<long long> checksum{0};
+    vector<thread> threads;
+    auto start = steady_clock::now();
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&queue, items_per_producer]()
+                             {
+            for (int i = 1; i <= items_per_producer; ++i) queue.push(i); });
+    }
+    for (int c = 0; c < consumers; ++c)
+    {
+        long long share = total / consumers + (c < total % consumers ? 1 : 0);
+        threads.emplace_back([&queue, &checksum, share]()
+                             {
+            long long sum = 0;
+            for (long long i = 0; i < share; ++i) sum += queue.pop();
+            checksum += sum; });
+    }
+    for (auto &t : threads)
+        t.join();
+    double elapsed = duration<double>(steady_clock::now() - start).count();
+    if (checksum.load() != producers * (static_cast<long long>(items_per_producer) * (items_per_producer + 1) / 2))
+        cout << "CHECKSUM MISMATCH - items lost or duplicated!" << endl;
+    return total / elapsed;
+}
+
+void benchmark_queues()
+{
+    const int ITEMS = 2000000; // Per producer
+    const size_t CAPACITY = 1024;
+    cout << "\n=== BOUNDED BUFFER BENCHMARK (items/sec, capacity " << CAPACITY << ") ===" << endl;
+    cout << "Producers x Consumers   mutex + cv   MPMC ring" << endl;
+    for (int threads : {1, 2, 4, 8})
+    {
+        int items = ITEMS / threads;
+        double locked = queue_throughput<MutexBoundedBuffer>(threads, threads, items, CAPACITY);
+        double ring = queue_throughput<MPMCQueue<int>>(threads, threads, items, CAPACITY);
+        printf("%9d x %-9d   %10.0f   %9.0f\n", threads, threads, locked, ring);
+    }
+}
 
 //=============================================================================
 // MAIN FUNCTION - RUN ALL DEMONSTRATIONS
 //=============================================================================
 
-int main()
+// Usage: synchronization_tools [--lock-free-buffer]  runs the demos, producer-consumer on the MPMC ring
+//        synchronization_tools --bench-semaphore     mutex+cv vs futex semaphore at 1-64 threads
+//        synchronization_tools --bench-queue         mutex+cv buffer vs MPMC ring, 1x1 to 8x8 threads
+//        synchronization_tools --bench-locks [tas|ttas|ticket|mcs|mutex]
+//                                                    spinlock throughput and fairness at 1-128 threads
+int main(int argc, char *argv[])
 {
+    string mode = argc > 1 ? argv[1] : "";
+    if (mode == "--bench-semaphore")
+    {
+        benchmark_semaphores();
+        return 0;
+    }
+    if (mode == "--bench-queue")
+    {
+        benchmark_queues();
+        return 0;
+    }
+    if (mode == "--bench-locks")
+    {
+        benchmark_locks(argc > 2 ? argv[2] : "");
+        return 0;
+    }
+
     cout << "CHAPTER 6: SYNCHRONIZATION TOOLS - C++17 IMPLEMENTATION" << endl;
     cout << "========================================================" << endl;
 
@@ -633,6 +1713,9 @@ int main()
         // 3. Hardware Instructions
         HardwareInstructions::demonstrate_test_and_set();
         HardwareInstructions::demonstrate_compare_and_swap();
+        HardwareInstructions::demonstrate_lock<TTASLock>("TTAS + BACKOFF");
+        HardwareInstructions::demonstrate_lock<TicketLock>("TICKET");
+        HardwareInstructions::demonstrate_lock<MCSLock>("MCS");
 
         // 4. Mutex Locks
         MutexDemo::demonstrate_mutex();
@@ -641,7 +1724,7 @@ int main()
         SemaphoreDemo::demonstrate_semaphore();
 
         // 6. Producer-Consumer Problem
-        ProducerConsumer::demonstrate_producer_consumer();
+        ProducerConsumer::demonstrate_producer_consumer(mode == "--lock-free-buffer");
 
         // 7. Monitor
         ResourceAllocator::demonstrate_monitor();
@@ -675,7 +1758,9 @@ int main()
  * 2. Peterson's algorithm for mutual exclusion
  * 3. Hardware-based synchronization primitives
  * 4. Mutex locks and their proper usage
- * 5. Semaphore operations and resource management (with custom implementation)
- * 6. Monitor concept and implementation
+ * 5. Semaphore operations and resource management (with custom implementation,
+ *    and a futex-based one whose uncontended path never takes a lock)
+ * 6. Monitor concept and implementation (its lock wait and hold times, and
+ *    the dining philosophers' chopsticks', are reported at exit by the lock profiler)
  * 7. Classic synchronization problems and solutions
  */